@@ -0,0 +1,90 @@
+// Contended updates from 1 to N threads: atomic_quantity against a raw
+// std::atomic of the same value type, and sharded_atomic_quantity, which
+// spreads the updates over cache lines.
+//
+//   g++ -std=c++20 -O2 -Iinclude bench/atomic.cpp -o atomic -pthread
+//   ./atomic [max threads] [increments per thread, in millions]
+
+#include "bench.hpp"
+
+#include <units_atomic.hpp>
+#include <units_si.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ratio>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace units;
+
+using kilojoule = scaled_unit<std::kilo, si::joule>;
+
+// Run body(t) on threads threads at once, and return the time taken.
+template <typename Body> double on_threads(int threads, Body body) {
+  return bench::best_of(3, [&] {
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+      pool.emplace_back(body, t);
+    for (auto &p : pool)
+      p.join();
+  });
+}
+
+template <typename T> void run(char const *type, int max_threads, long n) {
+  constexpr auto relaxed = std::memory_order_relaxed;
+
+  std::printf("%s\nthreads  raw atomic  atomic_quantity  sharded"
+              "   (ns per increment)\n",
+              type);
+
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    auto const per = 1e9 / static_cast<double>(n * threads);
+
+    std::atomic<T> raw{0};
+    auto const t_raw = on_threads(threads, [&](int) {
+      for (long i = 0; i < n; ++i)
+        raw.fetch_add(T{1}, relaxed);
+    });
+
+    atomic_quantity<T, si::joule> q{quantity_of<si::joule>(T{0})};
+    auto const t_q = on_threads(threads, [&](int) {
+      for (long i = 0; i < n; ++i)
+        q.fetch_add(quantity_of<si::joule>(T{1}), relaxed);
+    });
+
+    sharded_atomic_quantity<T, si::joule> s;
+    auto const t_s = on_threads(threads, [&](int) {
+      for (long i = 0; i < n; ++i)
+        s.add(quantity_of<si::joule>(T{1}));
+    });
+
+    std::printf("%7d  %10.2f  %15.2f  %7.2f\n", threads, t_raw * per,
+                t_q * per, t_s * per);
+  }
+
+  // The same, with the operand in kilojoules: one multiply more, folded at
+  // compile time, ahead of the same atomic instruction.
+  if constexpr (std::is_floating_point_v<T>) {
+    atomic_quantity<T, si::joule> q{quantity_of<si::joule>(T{0})};
+    auto const t = on_threads(1, [&](int) {
+      for (long i = 0; i < n; ++i)
+        q.fetch_add(quantity_of<kilojoule>(T{1}), relaxed);
+    });
+    std::printf("1 thread, adding kilojoules: %.2f ns per increment\n",
+                t * 1e9 / static_cast<double>(n));
+  }
+}
+
+int main(int argc, char **argv) {
+  auto const max_threads =
+      argc > 1 ? std::atoi(argv[1])
+               : static_cast<int>(std::thread::hardware_concurrency());
+  long const n = (argc > 2 ? std::atol(argv[2]) : 2) * 1000000;
+
+  run<long>("long", max_threads, n);
+  run<double>("double", max_threads, n);
+}
@@ -0,0 +1,48 @@
+#ifndef BST_UNITS_BENCH_HPP_
+#define BST_UNITS_BENCH_HPP_
+
+//==============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+//==============================================================================
+// Timing helpers shared by the benchmarks.
+namespace bench {
+
+//------------------------------------------------------------------------------
+
+// Make the optimizer assume that v is read, so that the work producing it is
+// not thrown away.
+template <typename T> inline void keep(T const &v) {
+  asm volatile("" : : "r"(&v) : "memory");
+}
+
+// The best of runs timings of f(), in seconds. The minimum is the figure least
+// disturbed by the rest of the machine.
+template <typename F> double best_of(int runs, F &&f) {
+  using clock = std::chrono::steady_clock;
+
+  auto best = std::chrono::duration<double>::max();
+  for (int i = 0; i < runs; ++i) {
+    auto const start = clock::now();
+    f();
+    best = std::min<std::chrono::duration<double>>(best, clock::now() - start);
+  }
+  return best.count();
+}
+
+// One line of a report: the time per item of each variant, and their ratio.
+inline void report(char const *name, std::size_t items, double raw,
+                   double units) {
+  auto const per = 1e9 / static_cast<double>(items);
+  std::printf("%-28s raw %8.3f ns  units %8.3f ns  ratio %.2f\n", name,
+              raw * per, units * per, units / raw);
+}
+
+} // namespace bench
+//==============================================================================
+
+#endif
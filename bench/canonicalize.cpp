@@ -0,0 +1,208 @@
+// Compile-time benchmark: canonicalizing derived units with constexpr arrays,
+// as units.hpp does, against the recursive type-list algorithms it replaced,
+// which are copied below. From the repository root, time the front end with
+// and without -DRECURSIVE:
+//
+//   time g++ -std=c++20 -fsyntax-only -Iinclude bench/canonicalize.cpp
+//   time g++ -std=c++20 -fsyntax-only -Iinclude -DRECURSIVE <same file>
+//
+// -DCHECK builds both and asserts that they agree on every unit.
+
+#include <units.hpp>
+
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#ifndef UNITS
+#define UNITS 400
+#endif
+
+//==============================================================================
+namespace recursive {
+
+using units::base_unit;
+using units::derived_unit;
+using units::exp;
+using units::scaled_unit;
+using units::detail::unit_power_pair;
+using units::meta::type_list;
+
+template <typename List1, typename List2> struct append;
+
+template <typename... Items1, typename... Items2>
+struct append<type_list<Items1...>, type_list<Items2...>> {
+  using type = type_list<Items1..., Items2...>;
+};
+
+template <template <typename> typename Op, typename List> struct map;
+
+template <template <typename> typename Op> struct map<Op, type_list<>> {
+  using type = type_list<>;
+};
+
+template <template <typename> typename Op, typename T, typename... Ts>
+struct map<Op, type_list<T, Ts...>> {
+  using type = typename append<type_list<typename Op<T>::type>,
+                               typename map<Op, type_list<Ts...>>::type>::type;
+};
+
+template <typename P1, typename P2> struct comp {
+  static const bool value = P1::unit::tag < P2::unit::tag;
+};
+
+template <typename T, typename List> struct insert;
+
+template <typename T> struct insert<T, type_list<>> {
+  using type = type_list<T>;
+};
+
+template <typename T, typename U, typename... Us>
+struct insert<T, type_list<U, Us...>> {
+  using type = std::conditional_t<
+      comp<T, U>::value, type_list<T, U, Us...>,
+      typename append<type_list<U>,
+                      typename insert<T, type_list<Us...>>::type>::type>;
+};
+
+template <typename List> struct sort;
+
+template <> struct sort<type_list<>> { using type = type_list<>; };
+
+template <typename T, typename... Ts> struct sort<type_list<T, Ts...>> {
+  using type = typename insert<T, typename sort<type_list<Ts...>>::type>::type;
+};
+
+template <typename List1, typename List2> struct merge;
+
+template <> struct merge<type_list<>, type_list<>> {
+  using type = type_list<>;
+};
+
+template <typename T, typename... Ts>
+struct merge<type_list<>, type_list<T, Ts...>> {
+  using type = type_list<T, Ts...>;
+};
+
+template <typename T, typename... Ts>
+struct merge<type_list<T, Ts...>, type_list<>> {
+  using type = type_list<T, Ts...>;
+};
+
+template <typename T, typename... Ts, typename U, typename... Us>
+struct merge<type_list<T, Ts...>, type_list<U, Us...>> {
+  using type = std::conditional_t<
+      comp<T, U>::value,
+      typename append<type_list<T>,
+                      typename merge<type_list<Ts...>,
+                                     type_list<U, Us...>>::type>::type,
+      std::conditional_t<
+          comp<U, T>::value,
+          typename append<type_list<U>,
+                          typename merge<type_list<T, Ts...>,
+                                         type_list<Us...>>::type>::type,
+          typename append<
+              type_list<unit_power_pair<typename T::unit,
+                                        T::power + U::power>>,
+              typename merge<type_list<Ts...>,
+                             type_list<Us...>>::type>::type>>;
+};
+
+template <typename List> struct remove_zero;
+
+template <> struct remove_zero<type_list<>> { using type = type_list<>; };
+
+template <typename T, typename... Ts> struct remove_zero<type_list<T, Ts...>> {
+  using rest = typename remove_zero<type_list<Ts...>>::type;
+  using type = std::conditional_t<T::power == 0, rest,
+                                  typename append<type_list<T>, rest>::type>;
+};
+
+template <typename... Params> struct parse;
+
+template <> struct parse<> { using type = type_list<>; };
+
+template <typename Unit, int P, typename... Params>
+struct parse<exp<Unit, P>, Params...> {
+  using type = typename append<type_list<unit_power_pair<Unit, P>>,
+                               typename parse<Params...>::type>::type;
+};
+
+template <typename Param, typename... Params> struct parse<Param, Params...> {
+  using type = typename append<type_list<unit_power_pair<Param, 1>>,
+                               typename parse<Params...>::type>::type;
+};
+
+template <typename Unit> struct flatten;
+
+template <int Tag> struct flatten<base_unit<Tag>> {
+  using type = type_list<unit_power_pair<base_unit<Tag>, 1>>;
+};
+
+template <typename Scale, typename Unit>
+struct flatten<scaled_unit<Scale, Unit>> : flatten<Unit> {};
+
+template <> struct flatten<type_list<>> { using type = type_list<>; };
+
+template <typename Pair, typename... Pairs>
+struct flatten<type_list<Pair, Pairs...>> {
+  template <typename P> struct op {
+    using type = unit_power_pair<typename P::unit, P::power * Pair::power>;
+  };
+
+  using updated = typename sort<typename map<
+      op, typename flatten<typename Pair::unit>::type>::type>::type;
+  using rest = typename sort<typename flatten<type_list<Pairs...>>::type>::type;
+
+  using type = typename remove_zero<typename merge<updated, rest>::type>::type;
+};
+
+template <typename... Params>
+struct flatten<derived_unit<Params...>>
+    : flatten<typename parse<Params...>::type> {};
+
+} // namespace recursive
+
+//==============================================================================
+// UNITS distinct derived units over eight base units, each nesting another
+// derived unit, so that both versions have to flatten and merge at two levels.
+
+template <int I> using b = units::base_unit<I % 8>;
+
+template <int I>
+using inner = units::derived_unit<
+    b<I>, units::exp<b<I + 3>, I / 8 + 1>,
+    units::scaled_unit<std::kilo, b<I + 5>>>;
+
+template <int I>
+using unit = units::derived_unit<
+    units::exp<inner<I>, I % 4 + 1>, units::exp<b<I + 1>, -(I % 5) - 1>,
+    b<I + 2>, units::exp<b<I + 6>, I + 2>, units::exp<inner<I + 1>, -1>>;
+
+template <typename Unit> struct fast {
+  using type = typename units::detail::get_base_unit_list<Unit>::type;
+};
+
+template <typename Unit> struct slow {
+  using type = typename recursive::flatten<Unit>::type;
+};
+
+template <std::size_t... I>
+constexpr std::size_t touch(std::index_sequence<I...>) {
+#if defined(CHECK)
+  static_assert((std::is_same_v<typename fast<unit<I>>::type,
+                                typename slow<unit<I>>::type> && ...));
+  return sizeof...(I);
+#elif defined(RECURSIVE)
+  return (std::size_t{0} + ... +
+          units::meta::type_list_length<typename slow<unit<I>>::type>::value);
+#else
+  return (std::size_t{0} + ... +
+          units::meta::type_list_length<typename fast<unit<I>>::type>::value);
+#endif
+}
+
+static_assert(touch(std::make_index_sequence<UNITS>{}) > 0);
+
+int main() {}
@@ -0,0 +1,133 @@
+// Code generation check: each quantity function below must compile to exactly
+// the same instructions as the raw double function after it. codegen.sh
+// builds this file at -O2 and -O3 and compares the pairs, and also counts the
+// instructions named in the EXPECT lines, so that a hidden divide or extra
+// conversion fails the check.
+//
+//   bench/codegen.sh [compiler]
+
+#include <units_atomic.hpp>
+#include <units_si.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <ratio>
+
+using namespace units;
+
+using metre = quantity<double, si::metre>;
+using kilometre = quantity<double, scaled_unit<std::kilo, si::metre>>;
+using second = quantity<double, si::second>;
+using area = quantity<double, si::square_metre>;
+using speed = quantity<double, si::metre_per_second>;
+
+extern "C" {
+
+// Scalar arithmetic.
+
+// EXPECT q_add addsd 1
+double q_add(metre a, metre b) { return (a + b).get(); }
+double raw_add(double a, double b) { return a + b; }
+
+// EXPECT q_sub subsd 1
+double q_sub(metre a, metre b) { return (a - b).get(); }
+double raw_sub(double a, double b) { return a - b; }
+
+// EXPECT q_mul mulsd 1
+double q_mul(metre a, metre b) { return area{a * b}.get(); }
+double raw_mul(double a, double b) { return a * b; }
+
+// EXPECT q_div divsd 1
+double q_div(metre a, second b) { return speed{a / b}.get(); }
+double raw_div(double a, double b) { return a / b; }
+
+// Scaled units: one multiply by a folded constant, never a divide.
+
+// EXPECT q_cast mulsd 1
+// EXPECT q_cast divsd 0
+double q_cast(kilometre a) { return unit_cast<si::metre>(a).get(); }
+double raw_cast(double a) { return a * 1000.0; }
+
+// EXPECT q_cast_down mulsd 1
+// EXPECT q_cast_down divsd 0
+double q_cast_down(metre a) {
+  return unit_cast<scaled_unit<std::kilo, si::metre>>(a).get();
+}
+double raw_cast_down(double a) { return a * 0.001; }
+
+// Mixed scales are added in the finer one, kilometres converted to metres.
+
+// EXPECT q_mixed_add mulsd 1
+// EXPECT q_mixed_add addsd 1
+// EXPECT q_mixed_add divsd 0
+double q_mixed_add(kilometre a, metre b) { return (a + b).get(); }
+double raw_mixed_add(double a, double b) { return a * 1000.0 + b; }
+
+// Loops.
+
+void q_add_loop(metre const *a, metre const *b, metre *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] + b[i];
+}
+void raw_add_loop(double const *a, double const *b, double *out,
+                  std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] + b[i];
+}
+
+void q_mul_loop(metre const *a, metre const *b, area *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] * b[i];
+}
+void raw_mul_loop(double const *a, double const *b, double *out,
+                  std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] * b[i];
+}
+
+void q_div_loop(metre const *a, second const *b, speed *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] / b[i];
+}
+void raw_div_loop(double const *a, double const *b, double *out,
+                  std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] / b[i];
+}
+
+void q_cast_loop(kilometre const *a, metre *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = unit_cast<si::metre>(a[i]);
+}
+void raw_cast_loop(double const *a, double *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] * 1000.0;
+}
+
+// EXPECT q_mixed_add_loop divsd 0
+// EXPECT q_mixed_add_loop divpd 0
+void q_mixed_add_loop(kilometre const *a, metre const *b, metre *out,
+                      std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] + b[i];
+}
+void raw_mixed_add_loop(double const *a, double const *b, double *out,
+                        std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = a[i] * 1000.0 + b[i];
+}
+
+// An atomic add of kilojoules into joules: the factor, then the same atomic
+// add as on a raw std::atomic<double>.
+
+// EXPECT q_atomic_add mulsd 1
+// EXPECT q_atomic_add divsd 0
+void q_atomic_add(atomic_quantity<double, si::joule> &a, double kj) {
+  a.fetch_add(quantity_of<scaled_unit<std::kilo, si::joule>>(kj),
+              std::memory_order_relaxed);
+}
+void raw_atomic_add(std::atomic<double> &a, double kj) {
+  a.fetch_add(kj * 1000.0, std::memory_order_relaxed);
+}
+
+} // extern "C"
@@ -0,0 +1,56 @@
+#!/bin/sh
+# Build codegen.cpp at -O2 and -O3 and check that every q_ function compiles
+# to the same instruction sequence as its raw_ counterpart, and that the
+# EXPECT lines hold. Register choices may differ; the instructions may not.
+# Exits non-zero on any difference.
+#
+#   bench/codegen.sh [compiler]
+
+set -eu
+
+cxx=${1:-g++}
+here=$(dirname "$0")
+src=$here/codegen.cpp
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+# The instruction mnemonics of one function, one per line, with labels,
+# directives and register-to-register moves dropped: the register allocator
+# shuffles arguments differently depending on the pointer types involved.
+body() {
+  awk -v fn="$2" '
+    $0 == fn ":" { on = 1; next }
+    on && $1 == ".cfi_endproc" { exit }
+    on && ($1 ~ /^\./ || $1 ~ /:$/) { next }
+    on && $1 ~ /^mov/ && $0 ~ /\t%[a-z0-9]+, %[a-z0-9]+$/ { next }
+    on { print $1 }
+  ' "$1"
+}
+
+status=0
+for opt in -O2 -O3; do
+  asm=$tmp/codegen$opt.s
+  "$cxx" -std=c++20 "$opt" -I"$here/../include" -S -o "$asm" "$src"
+
+  for q in $(sed -n 's/^[a-z].* \(q_[a-z_]*\)(.*/\1/p' "$src"); do
+    raw=raw_${q#q_}
+    body "$asm" "$q" > "$tmp/q"
+    body "$asm" "$raw" > "$tmp/raw"
+    if ! cmp -s "$tmp/q" "$tmp/raw"; then
+      echo "FAIL $opt: $q differs from $raw"
+      diff "$tmp/q" "$tmp/raw" || true
+      status=1
+    fi
+  done
+
+  sed -n 's|^// EXPECT ||p' "$src" | while read -r fn insn count; do
+    got=$(body "$asm" "$fn" | grep -cx "$insn" || true)
+    if [ "$got" -ne "$count" ]; then
+      echo "FAIL $opt: $fn has $got $insn, expected $count"
+      exit 1
+    fi
+  done || status=1
+done
+
+[ $status -eq 0 ] && echo "codegen: all functions match"
+exit $status
@@ -0,0 +1,104 @@
+// Lookups into a 1024-point interp_table: on a uniform grid one at a time and
+// through the span form, and on a non-uniform grid, which needs a binary
+// search. As a reference, the uniform lookup is also written out on raw
+// doubles.
+//
+//   g++ -std=c++20 -O3 -march=haswell -Iinclude bench/interp.cpp -o interp
+//   ./interp
+
+#include "bench.hpp"
+
+#include <bits/memory.hpp>
+#include <units_interp.hpp>
+#include <units_si.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+using namespace units;
+
+using kelvin = quantity<double, si::kelvin>;
+using pressure = quantity<double, si::pascal>;
+using table = interp_table<kelvin, pressure>;
+
+template <typename T> using buffer = std::vector<T, aligned_allocator<T>>;
+
+int main() {
+  constexpr std::size_t points = 1024;
+  constexpr std::size_t lookups = 1000000;
+  constexpr int runs = 7;
+
+  buffer<kelvin> grid(points, kelvin{0}), uneven(points, kelvin{0});
+  buffer<pressure> values(points, pressure{0});
+  for (std::size_t i = 0; i < points; ++i) {
+    auto const x = static_cast<double>(i);
+    grid[i] = kelvin{200 + 0.5 * x};
+    uneven[i] = kelvin{200 + 0.5 * x + 0.001 * x * x};
+    values[i] = pressure{std::exp(0.01 * x)};
+  }
+
+  std::vector<double> raw_values(points);
+  for (std::size_t i = 0; i < points; ++i)
+    raw_values[i] = values[i].get();
+
+  table const uniform{grid, values};
+  table const non_uniform{uneven, values};
+
+  // Inputs spread over the table and slightly past both ends.
+  std::uint64_t state = 88172645463325252u;
+  buffer<kelvin> in(lookups, kelvin{0});
+  std::vector<double> raw_in(lookups);
+  for (std::size_t i = 0; i < lookups; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    raw_in[i] = 190 + static_cast<double>(state % 540000) * 1e-3;
+    in[i] = kelvin{raw_in[i]};
+  }
+
+  buffer<pressure> out(lookups, pressure{0});
+  std::vector<double> raw_out(lookups);
+
+  auto const t_raw = bench::best_of(runs, [&] {
+    double const x0 = 200, inv_dx = 2, last = points - 1;
+    for (std::size_t i = 0; i < lookups; ++i) {
+      auto t = (raw_in[i] - x0) * inv_dx;
+      t = t > 0 ? t : 0;
+      t = t < last ? t : last;
+      auto j = static_cast<std::int32_t>(t);
+      j = j < static_cast<std::int32_t>(points - 2)
+              ? j
+              : static_cast<std::int32_t>(points - 2);
+      auto const f = t - j;
+      raw_out[i] = raw_values[j] + f * (raw_values[j + 1] - raw_values[j]);
+    }
+    bench::keep(raw_out);
+  });
+
+  auto const t_span = bench::best_of(runs, [&] {
+    uniform(std::span{in}, std::span{out});
+    bench::keep(out);
+  });
+
+  auto const t_single = bench::best_of(runs, [&] {
+    for (std::size_t i = 0; i < lookups; ++i)
+      out[i] = uniform(in[i]);
+    bench::keep(out);
+  });
+
+  auto const t_grid = bench::best_of(runs, [&] {
+    non_uniform(std::span{in}, std::span{out});
+    bench::keep(out);
+  });
+
+  auto const per = 1e9 / static_cast<double>(lookups);
+  std::printf("%zu lookups into %zu points, ns per lookup\n", lookups, points);
+  std::printf("raw uniform loop:        %.2f\n", t_raw * per);
+  std::printf("uniform, span:           %.2f\n", t_span * per);
+  std::printf("uniform, one at a time:  %.2f\n", t_single * per);
+  std::printf("non-uniform grid, span:  %.2f\n", t_grid * per);
+}
@@ -0,0 +1,134 @@
+// The covariance step of a Kalman filter, F * P * F^T + Q, for a 3-state
+// position/speed/acceleration model, against hand-written loops over plain
+// double arrays: once taking the same steps as the library, and once fused,
+// with F^T read in place and Q added into the sums.
+//
+//   g++ -std=c++20 -O3 -Iinclude bench/matrix.cpp -o matrix && ./matrix
+//
+// The two steps are out-of-line functions, so their code can be compared
+// too, e.g. by instruction count:
+//
+//   objdump -d --no-show-raw-insn matrix | awk '/<q_predict>:/,/ret/' | wc -l
+
+#include "bench.hpp"
+
+#include <units_matrix.hpp>
+#include <units_si.hpp>
+
+#include <cstddef>
+#include <cstdio>
+
+using namespace units;
+
+using speed = si::metre_per_second;
+using acceleration = si::metre_per_second_squared;
+
+using covariance = covariance_matrix<double, si::metre, speed, acceleration>;
+using transition = quantity_matrix<double, unit_list<si::metre, speed, acceleration>,
+                                   unit_list<si::metre, speed, acceleration>>;
+
+extern "C" {
+
+[[gnu::noinline]] void q_predict(transition const &F, covariance const &P,
+                                 covariance const &Q, covariance &out) {
+  out = F * P * transpose(F) + Q;
+}
+
+// The same steps on raw arrays: FP = F * P, F^T, FP * F^T, then + Q.
+[[gnu::noinline]] void raw_predict(double const *F, double const *P,
+                                   double const *Q, double *out) {
+  double FP[9], Ft[9], R[9];
+  for (std::size_t i = 0; i < 3; ++i)
+    for (std::size_t j = 0; j < 3; ++j) {
+      double sum = F[i * 3] * P[j];
+      for (std::size_t k = 1; k < 3; ++k)
+        sum += F[i * 3 + k] * P[k * 3 + j];
+      FP[i * 3 + j] = sum;
+    }
+
+  for (std::size_t i = 0; i < 3; ++i)
+    for (std::size_t j = 0; j < 3; ++j)
+      Ft[j * 3 + i] = F[i * 3 + j];
+
+  for (std::size_t i = 0; i < 3; ++i)
+    for (std::size_t j = 0; j < 3; ++j) {
+      double sum = FP[i * 3] * Ft[j];
+      for (std::size_t k = 1; k < 3; ++k)
+        sum += FP[i * 3 + k] * Ft[k * 3 + j];
+      R[i * 3 + j] = sum;
+    }
+
+  for (std::size_t i = 0; i < 9; ++i)
+    out[i] = R[i] + Q[i];
+}
+
+// Fused: FP = F * P, then out = Q + FP * F^T without forming F^T.
+[[gnu::noinline]] void raw_fused(double const *F, double const *P,
+                                 double const *Q, double *out) {
+  double FP[9] = {};
+  for (std::size_t i = 0; i < 3; ++i)
+    for (std::size_t k = 0; k < 3; ++k)
+      for (std::size_t j = 0; j < 3; ++j)
+        FP[i * 3 + j] += F[i * 3 + k] * P[k * 3 + j];
+
+  for (std::size_t i = 0; i < 3; ++i)
+    for (std::size_t j = 0; j < 3; ++j) {
+      double sum = Q[i * 3 + j];
+      for (std::size_t k = 0; k < 3; ++k)
+        sum += FP[i * 3 + k] * F[j * 3 + k];
+      out[i * 3 + j] = sum;
+    }
+}
+
+} // extern "C"
+
+int main() {
+  constexpr double dt = 0.01;
+  constexpr double f[9] = {1, dt, dt * dt / 2, 0, 1, dt, 0, 0, 1};
+  constexpr double p[9] = {4, 0.1, 0, 0.1, 1, 0.05, 0, 0.05, 0.5};
+  constexpr double q[9] = {1e-6, 0, 0, 0, 1e-4, 0, 0, 0, 1e-2};
+
+  transition F;
+  covariance P, Q;
+  for (std::size_t i = 0; i < 9; ++i) {
+    F.data()[i] = f[i];
+    P.data()[i] = p[i];
+    Q.data()[i] = q[i];
+  }
+
+  double raw_P[9];
+  for (std::size_t i = 0; i < 9; ++i)
+    raw_P[i] = p[i];
+
+  // Iterate the step, as a filter would, so that each call depends on the
+  // one before it.
+  constexpr std::size_t steps = 1000000;
+
+  auto raw = [&](auto step) {
+    return bench::best_of(7, [&] {
+      double x[9], y[9];
+      for (std::size_t i = 0; i < 9; ++i)
+        x[i] = raw_P[i];
+      for (std::size_t s = 0; s < steps; s += 2) {
+        step(f, x, q, y);
+        step(f, y, q, x);
+      }
+      bench::keep(x);
+    });
+  };
+
+  auto const t_raw = raw(raw_predict);
+  auto const t_fused = raw(raw_fused);
+
+  auto const t_units = bench::best_of(7, [&] {
+    covariance x = P, y;
+    for (std::size_t s = 0; s < steps; s += 2) {
+      q_predict(F, x, Q, y);
+      q_predict(F, y, Q, x);
+    }
+    bench::keep(x);
+  });
+
+  bench::report("F * P * F^T + Q, same steps", steps, t_raw, t_units);
+  bench::report("F * P * F^T + Q, fused", steps, t_fused, t_units);
+}
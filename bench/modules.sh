@@ -0,0 +1,106 @@
+#!/bin/sh
+# Build time of a generated project that uses the SI system, once including
+# units_si.hpp and once importing the units.si module. Each translation unit
+# holds ten functions that mix SI derived and prefixed units. The units are
+# compiled one after another, so the times add up as in a serial build.
+#
+#   bench/modules.sh [translation units] [compiler]
+#
+# Needs a compiler with -fmodules-ts, e.g. GCC 12.
+
+set -eu
+
+count=${1:-200}
+cxx=${2:-g++}
+root=$(cd "$(dirname "$0")/.." && pwd)
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+flags="-std=c++20 -O2 -I$root/include"
+
+# One translation unit's functions, which are the same in both variants.
+body() {
+  i=$1
+  cat <<EOF
+
+using namespace units;
+
+using kilometre = scaled_unit<std::kilo, si::metre>;
+using millisecond = scaled_unit<std::milli, si::second>;
+using kilowatt = scaled_unit<std::kilo, si::watt>;
+using kilopascal = scaled_unit<std::kilo, si::pascal>;
+
+double f${i}_0(double a, double b) {
+  return (quantity_of<kilometre>(a) + quantity_of<si::metre>(b)).get();
+}
+double f${i}_1(double d, double t) {
+  return quantity<double, si::metre_per_second>{
+      quantity_of<kilometre>(d) / quantity_of<millisecond>(t)}.get();
+}
+double f${i}_2(double m, double a) {
+  return quantity<double, si::newton>{
+      quantity_of<si::kilogram>(m) *
+      quantity_of<si::metre_per_second_squared>(a)}.get();
+}
+double f${i}_3(double p, double t) {
+  return quantity<double, si::joule>{quantity_of<kilowatt>(p) *
+                                     quantity_of<millisecond>(t)}.get();
+}
+double f${i}_4(double p, double a) {
+  return quantity<double, si::newton>{quantity_of<kilopascal>(p) *
+                                      quantity_of<si::square_metre>(a)}.get();
+}
+double f${i}_5(double v, double i) {
+  return quantity<double, si::watt>{quantity_of<si::volt>(v) *
+                                    quantity_of<si::ampere>(i)}.get();
+}
+double f${i}_6(double q, double v) {
+  return quantity<double, si::farad>{quantity_of<si::coulomb>(q) /
+                                     quantity_of<si::volt>(v)}.get();
+}
+double f${i}_7(double e, double m, double k) {
+  return quantity<double, si::joule_per_kilogram_kelvin>{
+      quantity_of<si::joule>(e) / quantity_of<si::kilogram>(m) /
+      quantity_of<si::kelvin>(k)}.get();
+}
+double f${i}_8(double b, double a) {
+  return quantity<double, si::weber>{quantity_of<si::tesla>(b) *
+                                     quantity_of<si::square_metre>(a)}.get();
+}
+double f${i}_9(double a, double b) {
+  return unit_cast<si::metre>(quantity_of<kilometre>(a) -
+                              quantity_of<si::metre>(b)).get();
+}
+EOF
+}
+
+mkdir "$tmp/header" "$tmp/module"
+i=0
+while [ "$i" -lt "$count" ]; do
+  { echo '#include <units_si.hpp>'; body "$i"; } > "$tmp/header/tu$i.cpp"
+  { echo '#include <ratio>'; echo 'import units.si;'; body "$i"; } \
+    > "$tmp/module/tu$i.cpp"
+  i=$((i + 1))
+done
+
+now() { date +%s.%N; }
+elapsed() { awk -v a="$1" -v b="$2" 'BEGIN { printf "%.1f s", b - a }'; }
+
+start=$(now)
+(cd "$tmp/header" && for f in tu*.cpp; do $cxx $flags -c "$f"; done)
+header=$(elapsed "$start" "$(now)")
+
+start=$(now)
+(cd "$tmp/module" &&
+  for m in units units.si; do
+    $cxx $flags -fmodules-ts -c -x c++ "$root/modules/$m.cppm" -o "$m.o"
+  done)
+interfaces=$(elapsed "$start" "$(now)")
+
+start=$(now)
+(cd "$tmp/module" && for f in tu*.cpp; do $cxx $flags -fmodules-ts -c "$f"; done)
+module=$(elapsed "$start" "$(now)")
+
+echo "$count translation units"
+echo "include units_si.hpp: $header"
+echo "import units.si:      $module, plus $interfaces for the interfaces"
@@ -0,0 +1,165 @@
+// Runtime cost of quantity arithmetic against the same loops over raw doubles.
+// A ratio near 1 is the expected result; codegen.sh checks the instructions
+// themselves.
+//
+//   g++ -std=c++20 -O2 -Iinclude bench/overhead.cpp -o overhead && ./overhead
+
+#include "bench.hpp"
+
+#include <bits/memory.hpp>
+#include <units_si.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ratio>
+#include <vector>
+
+using namespace units;
+
+using metre = quantity<double, si::metre>;
+using kilometre = quantity<double, scaled_unit<std::kilo, si::metre>>;
+using second = quantity<double, si::second>;
+using area = quantity<double, si::square_metre>;
+using speed = quantity<double, si::metre_per_second>;
+
+// Three arrays of n stay in L1; n is not a multiple of 512, so that they do
+// not sit a multiple of 4 KiB apart, where loads falsely wait on stores.
+constexpr std::size_t n = 1000;
+constexpr int reps = 8000;
+constexpr int runs = 15;
+
+// Both variants get page-aligned arrays, so that their layouts match.
+template <typename T> using buffer = std::vector<T, aligned_allocator<T, 4096>>;
+
+// Time reps passes of each variant over n elements. The variants take turns,
+// so that both see the same state of the machine.
+template <typename Raw, typename Units>
+void run(char const *name, Raw &&raw, Units &&units) {
+  double t_raw = 1e300;
+  double t_units = 1e300;
+  for (int i = 0; i < runs; ++i) {
+    t_raw = std::min(t_raw, bench::best_of(1, [&] {
+                       for (int r = 0; r < reps; ++r)
+                         raw();
+                     }));
+    t_units = std::min(t_units, bench::best_of(1, [&] {
+                         for (int r = 0; r < reps; ++r)
+                           units();
+                       }));
+  }
+  bench::report(name, n * reps, t_raw, t_units);
+}
+
+int main() {
+  buffer<double> a(n), b(n), out(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = 1.0 + static_cast<double>(i);
+    b[i] = 2.0 + static_cast<double>(i % 7);
+  }
+
+  buffer<metre> qa(n, metre{0}), qb(n, metre{0}), qout(n, metre{0});
+  buffer<kilometre> qk(n, kilometre{0});
+  buffer<second> qs(n, second{0});
+  buffer<area> qarea(n, area{0});
+  buffer<speed> qspeed(n, speed{0});
+  for (std::size_t i = 0; i < n; ++i) {
+    qa[i] = metre{a[i]};
+    qb[i] = metre{b[i]};
+    qk[i] = kilometre{a[i]};
+    qs[i] = second{b[i]};
+  }
+
+  run(
+      "add loop",
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = a[i] + b[i];
+        bench::keep(out);
+      },
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          qout[i] = qa[i] + qb[i];
+        bench::keep(qout);
+      });
+
+  run(
+      "sub loop",
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = a[i] - b[i];
+        bench::keep(out);
+      },
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          qout[i] = qa[i] - qb[i];
+        bench::keep(qout);
+      });
+
+  run(
+      "mul loop",
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = a[i] * b[i];
+        bench::keep(out);
+      },
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          qarea[i] = qa[i] * qb[i];
+        bench::keep(qarea);
+      });
+
+  run(
+      "div loop",
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = a[i] / b[i];
+        bench::keep(out);
+      },
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          qspeed[i] = qa[i] / qs[i];
+        bench::keep(qspeed);
+      });
+
+  run(
+      "unit_cast km -> m",
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = a[i] * 1000.0;
+        bench::keep(out);
+      },
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          qout[i] = unit_cast<si::metre>(qk[i]);
+        bench::keep(qout);
+      });
+
+  run(
+      "mixed add km + m",
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = a[i] * 1000.0 + b[i];
+        bench::keep(out);
+      },
+      [&] {
+        for (std::size_t i = 0; i < n; ++i)
+          qout[i] = qk[i] + qb[i];
+        bench::keep(qout);
+      });
+
+  // A dependent chain, which cannot vectorize: the scalar cost.
+  run(
+      "scalar mixed add chain",
+      [&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < n; ++i)
+          sum = (sum * 1000.0 + b[i]) * 0.001;
+        bench::keep(sum);
+      },
+      [&] {
+        kilometre sum{0};
+        for (std::size_t i = 0; i < n; ++i)
+          sum = unit_cast<scaled_unit<std::kilo, si::metre>>(sum + qb[i]);
+        bench::keep(sum);
+      });
+}
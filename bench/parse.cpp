@@ -0,0 +1,99 @@
+// Parse rate of unit expressions through a symbol_table, and the cost of a
+// single symbol lookup against a std::unordered_map keyed by string_view, the
+// usual hand-rolled alternative.
+//
+//   g++ -std=c++20 -O2 -Iinclude bench/parse.cpp -o parse && ./parse
+
+#include "bench.hpp"
+
+#include <units_parse.hpp>
+#include <units_si.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <optional>
+#include <ratio>
+#include <string_view>
+#include <unordered_map>
+
+using namespace units;
+
+using kilometre = scaled_unit<std::kilo, si::metre>;
+using millimetre = scaled_unit<std::milli, si::metre>;
+using gram = scaled_unit<std::milli, si::kilogram>;
+using millisecond = scaled_unit<std::milli, si::second>;
+using minute = scaled_unit<std::ratio<60>, si::second>;
+using hour = scaled_unit<std::ratio<3600>, si::second>;
+using kilojoule = scaled_unit<std::kilo, si::joule>;
+using kilowatt = scaled_unit<std::kilo, si::watt>;
+using kilopascal = scaled_unit<std::kilo, si::pascal>;
+
+constexpr auto symbols = make_symbol_table(
+    symbol<si::metre>("m"), symbol<kilometre>("km"),
+    symbol<millimetre>("mm"), symbol<si::kilogram>("kg"),
+    symbol<gram>("g"), symbol<si::second>("s"), symbol<millisecond>("ms"),
+    symbol<minute>("min"), symbol<hour>("h"), symbol<si::kelvin>("K"),
+    symbol<si::ampere>("A"), symbol<si::mole>("mol"),
+    symbol<si::candela>("cd"), symbol<si::newton>("N"),
+    symbol<si::joule>("J"), symbol<kilojoule>("kJ"), symbol<si::watt>("W"),
+    symbol<kilowatt>("kW"), symbol<si::pascal>("Pa"),
+    symbol<kilopascal>("kPa"), symbol<si::hertz>("Hz"),
+    symbol<si::volt>("V"), symbol<si::coulomb>("C"), symbol<si::ohm>("Ohm"));
+
+constexpr std::string_view expressions[] = {
+    "kg*m/s^2", "km/h",      "m/s",     "J/kg/K",   "kW*h",
+    "1/s",      "mol/m^3",   "N*m",     "kPa",      "mm",
+    "V*A",      "kg / m^3",  "m^2",     "W/m^2/K",  "ms",
+    "Ohm*m",    "C/kg",      "km/s^2",  "g/mol",    "kJ/kg",
+};
+
+constexpr std::string_view lookups[] = {"m",  "km",  "kg", "s",   "h",
+                                        "N",  "J",   "Pa", "kPa", "W",
+                                        "mm", "mol", "K",  "Ohm", "min"};
+
+int main() {
+  constexpr std::size_t rounds = 200000;
+  constexpr int runs = 7;
+
+  for (auto e : expressions)
+    if (!symbols.parse(e)) {
+      std::printf("cannot parse %.*s\n", static_cast<int>(e.size()), e.data());
+      return 1;
+    }
+
+  // Whole expressions.
+  auto const n_expr = std::size(expressions) * rounds;
+  auto const t_parse = bench::best_of(runs, [&] {
+    for (std::size_t r = 0; r < rounds; ++r)
+      for (auto e : expressions) {
+        auto u = symbols.parse(e);
+        bench::keep(u);
+      }
+  });
+  std::printf("parse: %.1f M expressions/s, %.1f ns each\n",
+              static_cast<double>(n_expr) / t_parse / 1e6,
+              t_parse * 1e9 / static_cast<double>(n_expr));
+
+  // Single symbols, against a hash map holding the same entries; "raw" in the
+  // report is the map.
+  std::unordered_map<std::string_view, parsed_unit> map;
+  for (auto s : lookups)
+    map.emplace(s, *symbols.find(s));
+
+  auto const n_find = std::size(lookups) * rounds;
+  auto const t_map = bench::best_of(runs, [&] {
+    for (std::size_t r = 0; r < rounds; ++r)
+      for (auto s : lookups) {
+        auto it = map.find(s);
+        bench::keep(it);
+      }
+  });
+  auto const t_table = bench::best_of(runs, [&] {
+    for (std::size_t r = 0; r < rounds; ++r)
+      for (auto s : lookups) {
+        auto u = symbols.find(s);
+        bench::keep(u);
+      }
+  });
+  bench::report("symbol lookup", n_find, t_map, t_table);
+}
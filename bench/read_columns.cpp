@@ -0,0 +1,142 @@
+// Ingest throughput of read_columns on a synthetic file of measurements, by
+// default 1 GiB, with a unit in every cell ("12.5 km, 300 ms, 293.1 K"). As a
+// reference, the same bytes are also scanned by a bare std::from_chars loop
+// that does nothing with units.
+//
+//   g++ -std=c++20 -O2 -Iinclude bench/read_columns.cpp -o read_columns
+//   ./read_columns [path] [MiB] [row bytes]
+//
+// The file is written to path, /tmp/units_bench.csv by default, and left
+// there for later runs; delete it to generate a new one.
+//
+// Given a row length, every row is padded with trailing blanks to that many
+// bytes. That keeps the columns small while the file grows past 4 GiB, so
+// that offsets beyond 32 bits can be checked on a machine with less memory
+// than the file, e.g. ./read_columns /tmp/big.csv 4608 1024. The rows read
+// are checked against the lines in the file.
+
+#include "bench.hpp"
+
+#include <units_mapped_file.hpp>
+#include <units_si.hpp>
+#include <units_text.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ratio>
+#include <string>
+#include <sys/stat.h>
+
+using namespace units;
+
+using kilometre = scaled_unit<std::kilo, si::metre>;
+using millisecond = scaled_unit<std::milli, si::second>;
+
+constexpr auto symbols =
+    make_symbol_table(symbol<si::metre>("m"), symbol<kilometre>("km"),
+                      symbol<si::second>("s"), symbol<millisecond>("ms"),
+                      symbol<si::kelvin>("K"));
+
+// Write rows, each padded to row_bytes if that is longer, until the file
+// holds at least bytes bytes.
+bool generate(char const *path, std::size_t bytes, std::size_t row_bytes) {
+  auto *f = std::fopen(path, "w");
+  if (!f)
+    return false;
+
+  std::uint64_t state = 88172645463325252u;
+  auto next = [&] {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+
+  std::string row(std::max<std::size_t>(row_bytes, 96), ' ');
+  std::size_t written = 0;
+  while (written < bytes) {
+    auto const r = next();
+    auto const n = std::snprintf(
+        row.data(), row.size(), "%u.%u km, %u ms, %u.%02u K",
+        static_cast<unsigned>(r % 1000), static_cast<unsigned>(r >> 10 & 7),
+        static_cast<unsigned>(r >> 13 & 1023),
+        static_cast<unsigned>(250 + (r >> 23 & 63)),
+        static_cast<unsigned>(r >> 29 & 63));
+    auto len = static_cast<std::size_t>(n);
+    if (len + 1 < row_bytes) {
+      std::fill(row.data() + len, row.data() + row_bytes - 1, ' ');
+      len = row_bytes - 1;
+    }
+    row[len++] = '\n';
+    std::fwrite(row.data(), 1, len, f);
+    written += len;
+  }
+
+  return std::fclose(f) == 0;
+}
+
+int main(int argc, char **argv) {
+  char const *path = argc > 1 ? argv[1] : "/tmp/units_bench.csv";
+  std::size_t const mib = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+  std::size_t const row_bytes =
+      argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 0;
+
+  struct stat st;
+  if (::stat(path, &st) != 0 || static_cast<std::size_t>(st.st_size) < mib << 20) {
+    std::printf("writing %zu MiB to %s\n", mib, path);
+    if (!generate(path, mib << 20, row_bytes)) {
+      std::perror(path);
+      return 1;
+    }
+  }
+
+  mapped_file file{path};
+  auto const text = file.text();
+  auto const gib = static_cast<double>(text.size()) / (1 << 30);
+
+  // A bare pass that only reads the numbers, which also pulls the file into
+  // the page cache for the timed passes below.
+  auto const t_scan = bench::best_of(3, [&] {
+    double sum = 0;
+    for (auto const *p = text.data(), *end = p + text.size(); p != end;) {
+      if (*p < '0' || *p > '9') {
+        ++p;
+        continue;
+      }
+      double v;
+      p = std::from_chars(p, end, v).ptr;
+      sum += v;
+    }
+    bench::keep(sum);
+  });
+
+  std::size_t rows = 0;
+  auto const t_read = bench::best_of(3, [&] {
+    quantity_array<double, si::metre> distance(0);
+    quantity_array<double, si::second> time(0);
+    quantity_array<double, si::kelvin> temperature(0);
+    distance.reserve(text.size() / 24);
+    time.reserve(text.size() / 24);
+    temperature.reserve(text.size() / 24);
+
+    rows = read_columns(text, symbols, read_options{}, distance, time,
+                        temperature);
+    bench::keep(distance);
+  });
+
+  auto const lines =
+      static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n'));
+  if (rows != lines) {
+    std::printf("read %zu rows from %zu lines\n", rows, lines);
+    return 1;
+  }
+
+  std::printf("%.2f GiB, %zu rows\n", gib, rows);
+  std::printf("from_chars scan: %.2f GiB/s\n", gib / t_scan);
+  std::printf("read_columns:    %.2f GiB/s, %.1f M rows/s\n", gib / t_read,
+              static_cast<double>(rows) / t_read / 1e6);
+}
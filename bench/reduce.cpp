@@ -0,0 +1,77 @@
+// Scaling of units::reduce and units::inner_product with the number of
+// threads, plain and compensated, against std::transform_reduce on raw
+// doubles. libstdc++ runs the parallel policies on TBB, whose thread count
+// is capped here with tbb::global_control.
+//
+//   g++ -std=c++20 -O2 -Iinclude bench/reduce.cpp -o reduce -ltbb
+//   ./reduce [max threads] [millions of elements]
+
+#include "bench.hpp"
+
+#include <units_algorithm.hpp>
+#include <units_si.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <execution>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <tbb/global_control.h>
+
+using namespace units;
+
+using force = quantity<double, si::newton>;
+using length = quantity<double, si::metre>;
+
+int main(int argc, char **argv) {
+  auto const max_threads =
+      argc > 1 ? std::atoi(argv[1])
+               : static_cast<int>(std::thread::hardware_concurrency());
+  std::size_t const n =
+      (argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32) * 1000000;
+
+  std::vector<double> raw_f(n), raw_d(n);
+  std::vector<force> f(n, force{0});
+  std::vector<length> d(n, length{0});
+  for (std::size_t i = 0; i < n; ++i) {
+    raw_f[i] = 1.0 + static_cast<double>(i % 1000) * 1e-3;
+    raw_d[i] = 0.5 + static_cast<double>(i % 7);
+    f[i] = force{raw_f[i]};
+    d[i] = length{raw_d[i]};
+  }
+
+  auto const per = 1e9 / static_cast<double>(n);
+  std::printf("%zu M elements, ns per element\n", n / 1000000);
+  std::printf("threads  raw sum  reduce  compensated  raw dot  inner_product"
+              "  compensated\n");
+
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    tbb::global_control limit{tbb::global_control::max_allowed_parallelism,
+                              static_cast<std::size_t>(threads)};
+    auto const par = std::execution::par_unseq;
+
+    auto const raw_sum = bench::best_of(5, [&] {
+      bench::keep(std::reduce(par, raw_d.begin(), raw_d.end(), 0.0));
+    });
+    auto const sum = bench::best_of(5, [&] { bench::keep(reduce(par, d)); });
+    auto const sum_c = bench::best_of(5, [&] {
+      bench::keep(reduce<summation::compensated>(par, d));
+    });
+    auto const raw_dot = bench::best_of(5, [&] {
+      bench::keep(std::transform_reduce(par, raw_f.begin(), raw_f.end(),
+                                        raw_d.begin(), 0.0));
+    });
+    auto const dot =
+        bench::best_of(5, [&] { bench::keep(inner_product(par, f, d)); });
+    auto const dot_c = bench::best_of(5, [&] {
+      bench::keep(inner_product<summation::compensated>(par, f, d));
+    });
+
+    std::printf("%7d  %7.3f  %6.3f  %11.3f  %7.3f  %13.3f  %11.3f\n",
+                threads, raw_sum * per, sum * per, sum_c * per, raw_dot * per,
+                dot * per, dot_c * per);
+  }
+}
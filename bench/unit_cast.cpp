@@ -0,0 +1,81 @@
+// The span form of unit_cast, metres to kilometres on doubles and millimetres
+// to metres on 32-bit integers, against the same scaling written out on raw
+// arrays and against a memcpy of the same bytes. Each runs on an array that
+// fits in L1 and on one far larger than the last level cache; throughput
+// counts the bytes read plus the bytes written.
+//
+//   g++ -std=c++20 -O3 -march=haswell -Iinclude bench/unit_cast.cpp -o unit_cast
+//   ./unit_cast
+
+#include "bench.hpp"
+
+#include <bits/memory.hpp>
+#include <units.hpp>
+#include <units_si.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+using namespace units;
+
+template <typename T> using buffer = std::vector<T, aligned_allocator<T>>;
+
+// Throughput in GB/s of moving bytes, in and out, in seconds.
+static double gbps(std::size_t bytes, double seconds) {
+  return 2 * static_cast<double>(bytes) / seconds * 1e-9;
+}
+
+template <typename From, typename Unit, typename Raw>
+static void run(char const *name, std::size_t n, int runs, Raw raw_scale) {
+  using rep = typename From::value_type;
+  using to_type = quantity<rep, Unit>;
+
+  buffer<From> in(n, From{0});
+  buffer<to_type> out(n, to_type{0});
+  std::vector<rep> raw_in(n), raw_out(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    raw_in[i] = static_cast<rep>(i % 1000 + 1000);
+    in[i] = From{raw_in[i]};
+  }
+
+  auto const t_copy = bench::best_of(runs, [&] {
+    std::memcpy(raw_out.data(), raw_in.data(), n * sizeof(rep));
+    bench::keep(raw_out);
+  });
+
+  auto const t_raw = bench::best_of(runs, [&] {
+    for (std::size_t i = 0; i < n; ++i)
+      raw_out[i] = raw_scale(raw_in[i]);
+    bench::keep(raw_out);
+  });
+
+  auto const t_units = bench::best_of(runs, [&] {
+    unit_cast<Unit>(std::span{in}, std::span{out});
+    bench::keep(out);
+  });
+
+  auto const bytes = n * sizeof(rep);
+  std::printf("%-24s %10zu  memcpy %6.1f  raw %6.1f  unit_cast %6.1f GB/s\n",
+              name, n, gbps(bytes, t_copy), gbps(bytes, t_raw),
+              gbps(bytes, t_units));
+}
+
+int main() {
+  using kilometre = si::kilo<si::metre>;
+  using millimetre = si::milli<si::metre>;
+
+  constexpr std::size_t small = 2048;
+  constexpr std::size_t large = std::size_t{1} << 25;
+
+  for (auto [n, runs] : {std::pair{small, 20001}, std::pair{large, 7}}) {
+    run<quantity<double, si::metre>, kilometre>(
+        "double m -> km", n, runs, [](double x) { return x * 1e-3; });
+    run<quantity<std::int32_t, millimetre>, si::metre>(
+        "int32 mm -> m", n, runs, [](std::int32_t x) { return x / 1000; });
+  }
+}
@@ -0,0 +1,78 @@
+//==============================================================================
+
+#include <units_affine.hpp>
+#include <units_si.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <ratio>
+#include <span>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using celsius = affine_unit<std::ratio<27315, 100>, std::ratio<1>, si::kelvin>;
+using fahrenheit =
+    affine_unit<std::ratio<45967, 180>, std::ratio<5, 9>, si::kelvin>;
+
+bool close(double a, double b) { return std::abs(a - b) <= 1e-9; }
+
+int main() {
+  bool ok = true;
+
+  // Points round trip between the scales, through kelvin and directly.
+  for (double c : {-273.15, -40.0, 0.0, 36.6, 100.0, 1000.0}) {
+    auto const p = quantity_point_of<celsius>(c);
+    auto const k = unit_cast<si::kelvin>(p);
+    auto const f = unit_cast<fahrenheit>(p);
+
+    ok &= close(k.get(), c + 273.15);
+    ok &= close(f.get(), c * 9 / 5 + 32);
+    ok &= close(unit_cast<celsius>(k).get(), c);
+    ok &= close(unit_cast<celsius>(f).get(), c);
+    ok &= close(unit_cast<celsius>(unit_cast<si::kelvin>(f)).get(), c);
+  }
+
+  // The span form gives the same points as converting one at a time.
+  quantity_point<double, fahrenheit> const from[] = {
+      quantity_point_of<fahrenheit>(-40.0), quantity_point_of<fahrenheit>(32.0),
+      quantity_point_of<fahrenheit>(212.0)};
+  quantity_point<double, celsius> to[3] = {
+      quantity_point_of<celsius>(0.0), quantity_point_of<celsius>(0.0),
+      quantity_point_of<celsius>(0.0)};
+  unit_cast<celsius>(std::span{from}, std::span{to});
+
+  for (std::size_t i = 0; i < 3; ++i)
+    ok &= to[i].get() == unit_cast<celsius>(from[i]).get();
+  ok &= close(to[0].get(), -40) && close(to[1].get(), 0) &&
+        close(to[2].get(), 100);
+
+  // The difference between two points carries no offset: 20 degrees Celsius
+  // apart is 20 kelvin and 36 degrees Fahrenheit.
+  auto const warm = quantity_point_of<celsius>(30.0);
+  auto const cool = quantity_point_of<celsius>(10.0);
+  auto const diff = warm - cool;
+  ok &= diff.get() == 20.0 && unit_cast<si::kelvin>(diff).get() == 20.0 &&
+        close(unit_cast<fahrenheit>(diff).get(), 36.0);
+  ok &= cool + diff == warm && warm - diff == cool;
+
+  // Mixed integral and floating point points compare and subtract in their
+  // common value type, so 26.86 degrees Celsius is not truncated to 300 K.
+  auto const whole = quantity_point_of<si::kelvin>(300);
+  auto const fraction = quantity_point_of<celsius>(26.86);
+  ok &= !(whole == fraction) && !(fraction == whole) && whole < fraction &&
+        fraction > whole && close((fraction - whole).get(), 0.01) &&
+        close((whole - fraction).get(), -0.01);
+
+  if (!ok) {
+    std::cerr << "an affine conversion did not round trip" << std::endl;
+    return 1;
+  }
+
+  auto const boiling = unit_cast<fahrenheit>(quantity_point_of<celsius>(100.0));
+  std::cout << "100 C = " << boiling.get() << " F" << std::endl;
+}
+
+//==============================================================================
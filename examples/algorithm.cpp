@@ -0,0 +1,51 @@
+//==============================================================================
+
+#include <units_algorithm.hpp>
+#include <units_si.hpp>
+
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  std::vector<quantity<double, si::newton>> const forces{
+      quantity_of<si::newton>(2.0), quantity_of<si::newton>(4.0),
+      quantity_of<si::newton>(0.5)};
+  std::vector<quantity<double, si::metre>> const distances{
+      quantity_of<si::metre>(3.0), quantity_of<si::metre>(0.25),
+      quantity_of<si::metre>(8.0)};
+
+  // Newtons times metres sum to joules.
+  auto const work = inner_product(forces, distances);
+  static_assert(
+      std::is_same_v<decltype(work), quantity<double, si::joule> const>);
+
+  auto const total = reduce(forces);
+  auto const squares =
+      transform_reduce(distances, [](auto d) { return d * d; });
+
+  if (work.get() != 11.0 || total.get() != 6.5 || squares.get() != 73.0625) {
+    std::cerr << "reductions gave " << work.get() << " J, " << total.get()
+              << " N, " << squares.get() << " m^2" << std::endl;
+    return 1;
+  }
+
+  // A small term between two large ones that cancel is lost to rounding in a
+  // plain sum, but kept by compensated summation.
+  std::vector<quantity<double, si::metre>> const spread{
+      quantity_of<si::metre>(1e16), quantity_of<si::metre>(1.0),
+      quantity_of<si::metre>(-1e16)};
+  auto const kept = reduce<summation::compensated>(spread);
+  if (kept.get() != 1.0) {
+    std::cerr << "compensated sum gave " << kept.get() << " m" << std::endl;
+    return 1;
+  }
+
+  std::cout << work.get() << " J" << std::endl;
+}
+
+//==============================================================================
@@ -0,0 +1,37 @@
+//==============================================================================
+
+#include <units_si.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <ratio>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  using degree =
+      scaled_unit<irrational_ratio<std::ratio<1, 180>, pi>, si::radian>;
+  using turn = scaled_unit<irrational_ratio<std::ratio<2>, pi>, si::radian>;
+
+  // pi cancels between degrees and turns, so integral values convert exactly.
+  auto const full = unit_cast<degree>(quantity_of<turn>(3));
+  if (full.get() != 1080) {
+    std::cerr << "3 turns gave " << full.get() << " degrees" << std::endl;
+    return 1;
+  }
+
+  // To radians, pi is folded into a single factor.
+  auto const right = unit_cast<si::radian>(quantity_of<degree>(90.0));
+  if (std::abs(right.get() - std::numbers::pi / 2) > 1e-15) {
+    std::cerr << "90 degrees gave " << right.get() << " rad" << std::endl;
+    return 1;
+  }
+
+  std::cout << full.get() << " degrees, " << right.get() << " rad"
+            << std::endl;
+}
+
+//==============================================================================
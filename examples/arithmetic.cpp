@@ -0,0 +1,56 @@
+//==============================================================================
+
+#include <units_si.hpp>
+
+#include <iostream>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  // An accumulator keeps its own scale whatever it is given.
+  auto total = quantity_of<si::metre>(0.0);
+  total += quantity_of<si::kilo<si::metre>>(1.5);
+  total += quantity_of<si::deca<si::metre>>(2.0);
+  total -= quantity_of<si::metre>(20.0);
+
+  static_assert(std::is_same_v<decltype(total), quantity<double, si::metre>>);
+
+  // Scaling by plain numbers keeps the unit.
+  auto const half = total * 0.5;
+  auto const twice = 2.0 * total;
+  auto const third = total / 3.0;
+
+  // Comparisons convert between scales, so 1.5 km == 1500 m.
+  bool const ok = total.get() == 1500.0 && half.get() == 750.0 &&
+                  twice.get() == 3000.0 && third.get() == 500.0 &&
+                  total == quantity_of<si::kilo<si::metre>>(1.5) &&
+                  half < quantity_of<si::kilo<si::metre>>(1.0) &&
+                  twice > total && third != total;
+
+  // Mixed integral and floating point comparisons truncate neither side, and
+  // give the same answer whichever way round they are written.
+  auto const one = quantity_of<si::metre>(1);
+  auto const almost_two = quantity_of<si::metre>(1.9);
+  auto const metres = quantity_of<si::metre>(1500);
+  auto const kilometres = quantity_of<si::kilo<si::metre>>(1.5004);
+
+  bool const mixed = !(almost_two == one) && !(one == almost_two) &&
+                     one < almost_two && almost_two > one &&
+                     !(metres == kilometres) && !(kilometres == metres) &&
+                     metres < kilometres && kilometres > metres &&
+                     metres == quantity_of<si::kilo<si::metre>>(1.5) &&
+                     quantity_of<si::kilo<si::metre>>(1.5) == metres;
+
+  if (!ok || !mixed) {
+    std::cerr << "arithmetic on " << total.get() << " m went wrong"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << total.get() << " m" << std::endl;
+}
+
+//==============================================================================
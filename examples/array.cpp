@@ -0,0 +1,51 @@
+//==============================================================================
+
+#include <units_array.hpp>
+#include <units_si.hpp>
+
+#include <iostream>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  quantity_array<double, si::metre> a(3);
+  quantity_array<double, si::kilo<si::metre>> b(3);
+  for (std::size_t i = 0; i < 3; ++i) {
+    a[i] = quantity_of<si::metre>(10.0 * static_cast<double>(i + 1));
+    b[i] = quantity_of<si::kilo<si::metre>>(static_cast<double>(i + 1));
+  }
+
+  // The kilometres are rescaled to metres as the sum is assigned.
+  quantity_array<double, si::metre> sum = a + b;
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    auto const expected = 1010.0 * static_cast<double>(i + 1);
+    if (sum[i].get() != expected) {
+      std::cerr << "sum[" << i << "] = " << sum[i].get() << ", expected "
+                << expected << std::endl;
+      return 1;
+    }
+  }
+
+  // A whole expression, with a scalar broadcast over it, is evaluated in one
+  // pass; its unit differs from the destination's only in scale, so the
+  // conversion is explicit.
+  auto const t = quantity_of<si::second>(2.0);
+  quantity_array<double, si::kilo<si::metre_per_second>> speed{(a + b) / t};
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    auto const expected = 0.505 * static_cast<double>(i + 1);
+    if (speed[i].get() != expected) {
+      std::cerr << "speed[" << i << "] = " << speed[i].get() << ", expected "
+                << expected << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << sum[0].get() << ' ' << sum[1].get() << ' ' << sum[2].get()
+            << std::endl;
+}
+
+//==============================================================================
@@ -0,0 +1,74 @@
+//==============================================================================
+
+#include <units_atomic.hpp>
+#include <units_si.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  using kilojoule = si::kilo<si::joule>;
+
+  // Updates in other scales are converted before the atomic operation.
+  atomic_quantity<long, si::joule> energy{quantity_of<kilojoule>(2L)};
+  energy.fetch_add(quantity_of<si::joule>(500L));
+  energy -= quantity_of<kilojoule>(1L);
+
+  auto expected = quantity_of<si::joule>(1500L);
+  bool ok =
+      energy.compare_exchange_strong(expected, quantity_of<kilojoule>(3L)) &&
+      energy.load().get() == 3000;
+
+  // A failed exchange reports the value it found.
+  expected = quantity_of<si::joule>(0L);
+  ok = ok &&
+       !energy.compare_exchange_strong(expected, quantity_of<si::joule>(1L)) &&
+       expected.get() == 3000;
+
+  // Separate orders for success and failure, as on std::atomic.
+  expected = quantity_of<si::joule>(3000L);
+  ok = ok &&
+       energy.compare_exchange_strong(expected, quantity_of<si::joule>(10L),
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_acquire) &&
+       energy.load().get() == 10;
+
+  // Adding millijoules directly would not compile, since the counter would
+  // drop them; the caller rounds them into its scale instead.
+  using millijoule = si::milli<si::joule>;
+  energy += unit_cast<si::joule, rounding::to_nearest>(
+      quantity_of<millijoule>(999L));
+  ok = ok && energy.load().get() == 11;
+
+  // Threads adding into a sharded counter lose nothing.
+  constexpr int threads = 4;
+  constexpr long per_thread = 100000;
+
+  sharded_atomic_quantity<long, si::joule> total;
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t)
+    pool.emplace_back([&] {
+      for (long i = 0; i < per_thread; ++i)
+        total += quantity_of<kilojoule>(1L);
+    });
+  for (auto &p : pool)
+    p.join();
+
+  auto const counted = total.reset();
+  ok = ok && counted.get() == threads * per_thread * 1000 &&
+       total.load().get() == 0;
+
+  if (!ok) {
+    std::cerr << "an atomic update was lost or misconverted" << std::endl;
+    return 1;
+  }
+
+  std::cout << counted.get() << " J" << std::endl;
+}
+
+//==============================================================================
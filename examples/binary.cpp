@@ -0,0 +1,99 @@
+//==============================================================================
+
+#include <units_binary.hpp>
+#include <units_si.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using kilometres = quantity<std::int64_t, si::kilo<si::metre>>;
+using metres = quantity<std::int64_t, si::metre>;
+using seconds = quantity<std::int64_t, si::second>;
+
+// The field of type T stored at the given offset into a batch.
+template <typename T> T field(std::byte const *batch, std::size_t offset) {
+  T v;
+  std::memcpy(&v, batch + offset, sizeof v);
+  return v;
+}
+
+int main() {
+  kilometres const values[] = {kilometres{3}, kilometres{-7},
+                               kilometres{40075}};
+
+  // The header takes 168 bytes, padded to the 64-byte aligned payload.
+  alignas(64) std::byte buf[512];
+  auto const n = encode_batch(std::span{values}, std::span{buf});
+
+  bool ok = n == 192 + 3 * 8 && encoded_batch_size(3, 8) == n;
+
+  // The layout of the header, field by field: magic, byte order, value kind
+  // and size, dimension count, payload offset, count, scale, and then the
+  // (tag, power) pairs of the dimension.
+  ok = ok && std::memcmp(buf, "UQB1", 4) == 0 &&
+       field<std::uint16_t>(buf, 4) == 0x0102 &&
+       field<std::uint8_t>(buf, 6) == 0 && field<std::uint8_t>(buf, 7) == 8 &&
+       field<std::uint32_t>(buf, 8) == 1 &&
+       field<std::uint32_t>(buf, 12) == 192 &&
+       field<std::uint64_t>(buf, 16) == 3 &&
+       field<std::int64_t>(buf, 24) == 1000 &&
+       field<std::int64_t>(buf, 32) == 1 && field<std::int32_t>(buf, 40) == 1 &&
+       field<std::int32_t>(buf, 44) == 1 &&
+       field<std::int64_t>(buf, 192 + 16) == 40075;
+
+  if (!ok) {
+    std::cerr << "the encoded batch does not have the expected layout"
+              << std::endl;
+    return 1;
+  }
+
+  // The same type is viewed in place; another scale is converted on read.
+  batch_reader const reader{std::span{buf}.first(n)};
+  auto const view = reader.view<kilometres>();
+
+  metres converted[3] = {metres{0}, metres{0}, metres{0}};
+  reader.read(std::span{converted});
+
+  for (std::size_t i = 0; i < 3; ++i)
+    if (view[i].get() != values[i].get() ||
+        converted[i].get() != 1000 * values[i].get()) {
+      std::cerr << "value " << i << " did not round trip" << std::endl;
+      return 1;
+    }
+
+  // Reading another dimension, or a damaged batch, throws.
+  seconds wrong[3] = {seconds{0}, seconds{0}, seconds{0}};
+  try {
+    reader.read(std::span{wrong});
+    std::cerr << "kilometres were read as seconds" << std::endl;
+    return 1;
+  } catch (std::domain_error const &) {
+  }
+
+  try {
+    batch_reader{std::span{buf}.first(n - 1)};
+    std::cerr << "a truncated batch was accepted" << std::endl;
+    return 1;
+  } catch (std::runtime_error const &) {
+  }
+
+  buf[0] = std::byte{'X'};
+  try {
+    batch_reader{std::span{buf}.first(n)};
+    std::cerr << "a batch without its magic was accepted" << std::endl;
+    return 1;
+  } catch (std::runtime_error const &) {
+  }
+
+  std::cout << n << " bytes for " << reader.size() << " values" << std::endl;
+}
+
+//==============================================================================
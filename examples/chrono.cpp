@@ -0,0 +1,57 @@
+//==============================================================================
+
+#include <units_chrono.hpp>
+#include <units_si.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+using namespace std::chrono_literals;
+
+using seconds = quantity<double, si::second>;
+using whole_seconds = quantity<long long, si::second>;
+using milliseconds = quantity<long long, si::milli<si::second>>;
+
+// As with chrono itself, conversions that lose nothing are implicit, and
+// those that truncate are explicit.
+static_assert(std::is_convertible_v<std::chrono::seconds, milliseconds>);
+static_assert(std::is_convertible_v<std::chrono::milliseconds, seconds>);
+static_assert(!std::is_convertible_v<std::chrono::milliseconds, whole_seconds>);
+static_assert(std::is_convertible_v<milliseconds, std::chrono::microseconds>);
+static_assert(!std::is_convertible_v<seconds, std::chrono::milliseconds>);
+
+int main() {
+  milliseconds const from_chrono = 3s;
+  seconds const fractional = 1500ms;
+  auto const truncated = static_cast<whole_seconds>(1500ms);
+  std::chrono::microseconds const to_chrono = milliseconds{7};
+
+  bool ok = from_chrono.get() == 3000 && fractional.get() == 1.5 &&
+            truncated.get() == 1 && to_chrono.count() == 7000;
+
+  // Far from the epoch, a double cannot hold the times themselves to the
+  // nanosecond, but the difference is taken in ticks first and is exact.
+  using clock = std::chrono::system_clock;
+  using stamp = timestamp<clock, seconds>;
+
+  auto const epoch_ns = std::chrono::nanoseconds{1'700'000'000'000'000'001};
+  stamp const a{clock::time_point{
+      std::chrono::duration_cast<clock::duration>(epoch_ns)}};
+  auto const b = a + quantity_of<si::micro<si::second>>(250.0);
+
+  ok = ok && b - a == quantity_of<si::micro<si::second>>(250.0) && a < b &&
+       b - quantity_of<si::micro<si::second>>(250.0) == a;
+
+  if (!ok) {
+    std::cerr << "a chrono conversion was off" << std::endl;
+    return 1;
+  }
+
+  std::cout << (b - a).get() << " s" << std::endl;
+}
+
+//==============================================================================
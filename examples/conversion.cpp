@@ -0,0 +1,58 @@
+//==============================================================================
+
+#include <units_si.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <ratio>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  using hour = scaled_unit<std::ratio<3600>, si::second>;
+  using kilometre_per_hour = derived_unit<si::kilo<si::metre>, exp<hour, -1>>;
+
+  // 1 km/h is 5/18 m/s. The multiply by 5 would overflow an int64_t here, so
+  // it goes through a wider intermediate, and the result comes out exact.
+  auto const fast = quantity_of<kilometre_per_hour>(
+      std::int64_t{9'000'000'000'000'000'000});
+  auto const in_si = unit_cast<si::metre_per_second>(fast);
+
+  if (in_si.get() != 2'500'000'000'000'000'000) {
+    std::cerr << "km/h to m/s gave " << in_si.get() << std::endl;
+    return 1;
+  }
+
+  // Integral conversions truncate toward zero, like integer division.
+  auto const back =
+      unit_cast<si::metre>(quantity_of<si::milli<si::metre>>(-1500));
+  if (back.get() != -1) {
+    std::cerr << "-1500 mm to m gave " << back.get() << std::endl;
+    return 1;
+  }
+
+  // A value that fits converts as unit_cast does; one that does not throws.
+  auto const near = quantity_of<si::kilo<si::metre>>(std::int64_t{9'000'000});
+  if (checked_unit_cast<si::milli<si::metre>>(near).get() !=
+      9'000'000'000'000) {
+    std::cerr << "checked_unit_cast changed an in-range value" << std::endl;
+    return 1;
+  }
+
+  auto const far =
+      quantity_of<si::kilo<si::metre>>(std::int64_t{9'000'000'000'000'000});
+  try {
+    checked_unit_cast<si::milli<si::metre>>(far);
+    std::cerr << "checked_unit_cast did not report an overflow" << std::endl;
+    return 1;
+  } catch (std::overflow_error const &e) {
+    std::cout << e.what() << std::endl;
+  }
+
+  std::cout << in_si.get() << " m/s" << std::endl;
+}
+
+//==============================================================================
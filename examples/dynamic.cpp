@@ -0,0 +1,53 @@
+//==============================================================================
+
+#include <units_dynamic.hpp>
+#include <units_si.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  dynamic_quantity<double> const d = quantity_of<si::kilo<si::metre>>(1.5);
+  dynamic_quantity<double> const e = quantity_of<si::metre>(500.0);
+  dynamic_quantity<double> const t = quantity_of<si::second>(100.0);
+
+  // Addition happens in the finer scale, and the result converts back to a
+  // static quantity once its dimension checks out.
+  auto const v = quantity<double, si::metre_per_second>{(d + e) / t};
+  if (v.get() != 20.0) {
+    std::cerr << "(1.5 km + 500 m) / 100 s gave " << v.get() << " m/s"
+              << std::endl;
+    return 1;
+  }
+
+  // Packed exponents keep their signs across lanes: m s^-2 times s^2 is m.
+  auto const seconds_squared = (t * t).dimension();
+  auto const accel = e.dimension() / seconds_squared;
+  if (accel * seconds_squared != e.dimension() ||
+      accel != dynamic_dimension::base(1) / dynamic_dimension::base(0, 2)) {
+    std::cerr << "packed dimensions did not round trip" << std::endl;
+    return 1;
+  }
+
+  try {
+    auto const bad = d + t;
+    std::cerr << "adding metres to seconds gave " << bad.get() << std::endl;
+    return 1;
+  } catch (std::domain_error const &) {
+  }
+
+  try {
+    dynamic_dimension::base(dynamic_dimension::max_base_units);
+    std::cerr << "an out of range tag was accepted" << std::endl;
+    return 1;
+  } catch (std::out_of_range const &) {
+  }
+
+  std::cout << v.get() << " m/s" << std::endl;
+}
+
+//==============================================================================
@@ -0,0 +1,71 @@
+//==============================================================================
+
+#include <units_cgs.hpp>
+#include <units_format.hpp>
+#include <units_si.hpp>
+
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#include <string>
+#endif
+
+//------------------------------------------------------------------------------
+
+// A base unit of a system of our own, named alongside those of SI and CGS,
+// which come with theirs.
+using pixel = units::base_unit<20>;
+template <> inline constexpr std::string_view units::base_unit_symbol<20> = "px";
+
+using namespace units;
+
+// The unit text is built at compile time: positive powers first, in tag
+// order, with any scale other than 1 at the front.
+static_assert(unit_symbol_of<quantity<double, si::newton>> == "m·kg·s⁻²");
+static_assert(unit_symbol_of<quantity<double, si::hertz>> == "s⁻¹");
+static_assert(unit_symbol_of<quantity<double, si::kilo<si::metre>>> ==
+              "1000·m");
+static_assert(unit_symbol_of<quantity<double, si::joule_per_kelvin>> ==
+              "m²·kg·s⁻²·K⁻¹");
+static_assert(unit_symbol_of<quantity<double, cgs::dyne>> == "cm·g·s⁻²");
+
+using pixels_per_metre = derived_unit<exp<pixel, 1>, exp<si::metre, -1>>;
+static_assert(unit_symbol_of<quantity<double, pixels_per_metre>> == "px·m⁻¹");
+
+int main() {
+  auto const f = quantity_of<si::newton>(9.81);
+
+  char buf[32];
+  auto const r = to_chars(buf, buf + sizeof buf, f);
+  auto const text = std::string_view{buf, r.ptr};
+  if (r.ec != std::errc{} || text != "9.81 m·kg·s⁻²") {
+    std::cerr << "to_chars wrote \"" << text << '"' << std::endl;
+    return 1;
+  }
+
+  // There is room for the value but not its unit.
+  char small[8];
+  if (to_chars(small, small + sizeof small, f).ec !=
+      std::errc::value_too_large) {
+    std::cerr << "to_chars overran a short buffer" << std::endl;
+    return 1;
+  }
+
+#if defined(__cpp_lib_format)
+  // Format specifications apply to the value alone.
+  auto const formatted =
+      std::format("{:.1f}|{:>5}", f, quantity_of<si::metre>(2.5));
+  if (formatted != "9.8 m·kg·s⁻²|  2.5 m") {
+    std::cerr << "std::format wrote \"" << formatted << '"' << std::endl;
+    return 1;
+  }
+#endif
+
+  std::cout << text << std::endl;
+}
+
+//==============================================================================
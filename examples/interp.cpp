@@ -0,0 +1,96 @@
+//==============================================================================
+
+#include <units_interp.hpp>
+#include <units_si.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using kelvin = quantity<double, si::kelvin>;
+using pascal = quantity<double, si::pascal>;
+using table = interp_table<kelvin, pascal>;
+
+int main() {
+  kelvin const even[] = {kelvin{300}, kelvin{310}, kelvin{320}, kelvin{330}};
+  kelvin const uneven[] = {kelvin{300}, kelvin{301}, kelvin{320}, kelvin{330}};
+  pascal const values[] = {pascal{1}, pascal{2}, pascal{4}, pascal{8}};
+
+  table const uniform{even, values};
+  table const grid{uneven, values};
+
+  // Lookups take any scale of temperature, and hold the end values outside
+  // the table.
+  bool ok = uniform.uniform() && !grid.uniform() &&
+            uniform(kelvin{305}).get() == 1.5 &&
+            uniform(quantity_of<si::milli<si::kelvin>>(315000.0)).get() == 3 &&
+            uniform(kelvin{290}).get() == 1 &&
+            uniform(kelvin{400}).get() == 8 &&
+            grid(kelvin{310.5}).get() == 3 && grid(kelvin{330}).get() == 8;
+
+  // The span lookups agree with single ones, on either kind of grid.
+  kelvin const in[] = {kelvin{299}, kelvin{300}, kelvin{300.5}, kelvin{317},
+                       kelvin{329.9}, kelvin{331}};
+  pascal out[6] = {pascal{0}, pascal{0}, pascal{0},
+                   pascal{0}, pascal{0}, pascal{0}};
+
+  for (auto const *t : {&uniform, &grid}) {
+    (*t)(std::span{in}, std::span{out});
+    for (std::size_t i = 0; i < 6; ++i)
+      ok = ok && out[i] == (*t)(in[i]);
+  }
+
+  // A NaN passes through a lookup, one at a time or in a span, rather than
+  // picking up an end value.
+  auto const nan = kelvin{std::numeric_limits<double>::quiet_NaN()};
+  kelvin const with_nan[] = {kelvin{305}, nan, kelvin{331}};
+  pascal nan_out[3] = {pascal{0}, pascal{0}, pascal{0}};
+  for (auto const *t : {&uniform, &grid}) {
+    (*t)(std::span{with_nan}, std::span{nan_out});
+    ok = ok && std::isnan((*t)(nan).get()) && std::isnan(nan_out[1].get()) &&
+         nan_out[0] == (*t)(kelvin{305}) && nan_out[2].get() == 8;
+  }
+
+  // at() looks up the same values inside the table, ends included, and
+  // throws outside it.
+  ok = ok && uniform.at(kelvin{305}) == uniform(kelvin{305}) &&
+       uniform.at(kelvin{330}).get() == 8 && grid.at(kelvin{300}).get() == 1;
+  for (auto const x : {kelvin{299.9}, kelvin{330.1}, nan})
+    for (auto const *t : {&uniform, &grid})
+      try {
+        t->at(x);
+        ok = false;
+      } catch (std::out_of_range const &) {
+      }
+
+  // Grids must be strictly increasing, and match the values in length.
+  kelvin const backwards[] = {kelvin{300}, kelvin{310}, kelvin{310},
+                              kelvin{330}};
+  try {
+    table{backwards, values};
+    ok = false;
+  } catch (std::invalid_argument const &) {
+  }
+
+  try {
+    table{std::span{even}.first(3), values};
+    ok = false;
+  } catch (std::invalid_argument const &) {
+  }
+
+  if (!ok) {
+    std::cerr << "an interpolated value was off" << std::endl;
+    return 1;
+  }
+
+  std::cout << uniform(kelvin{305}).get() << " Pa" << std::endl;
+}
+
+//==============================================================================
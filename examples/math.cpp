@@ -0,0 +1,61 @@
+//==============================================================================
+
+#include <units_math.hpp>
+#include <units_si.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  using kilometre = si::kilo<si::metre>;
+  using millimetre = si::milli<si::metre>;
+
+  // The result units are worked out at compile time; the calls are found by
+  // argument dependent lookup.
+  auto const side = sqrt(quantity_of<si::square_metre>(16.0));
+  static_assert(
+      std::is_same_v<decltype(side), quantity<double, si::metre> const>);
+
+  auto const volume = pow<3>(quantity_of<kilometre>(2.0));
+  auto const edge = cbrt(volume);
+  static_assert(
+      std::is_same_v<decltype(edge), quantity<double, kilometre> const>);
+
+  // hypot works in the finer of its two scales; fma in the scale of z.
+  auto const diagonal =
+      hypot(quantity_of<si::metre>(3.0), quantity_of<millimetre>(4000.0));
+  auto const energy = fma(quantity_of<si::newton>(2.0),
+                          quantity_of<si::metre>(3.0),
+                          quantity_of<si::joule>(0.5));
+
+  bool ok = side.get() == 4.0 && volume.get() == 8.0 && edge.get() == 2.0 &&
+            unit_cast<millimetre>(diagonal).get() == 5000.0 &&
+            unit_cast<si::joule>(energy).get() == 6.5;
+
+  // The span forms agree with the scalar ones.
+  quantity<double, si::square_metre> const areas[] = {
+      quantity_of<si::square_metre>(1.0), quantity_of<si::square_metre>(2.25),
+      quantity_of<si::square_metre>(9.0)};
+  quantity<double, si::metre> roots[3] = {quantity_of<si::metre>(0.0),
+                                          quantity_of<si::metre>(0.0),
+                                          quantity_of<si::metre>(0.0)};
+  sqrt(std::span{areas}, std::span{roots});
+
+  for (std::size_t i = 0; i < 3; ++i)
+    ok &= roots[i] == sqrt(areas[i]);
+
+  if (!ok) {
+    std::cerr << "a math function gave the wrong quantity" << std::endl;
+    return 1;
+  }
+
+  std::cout << diagonal.get() << " mm" << std::endl;
+}
+
+//==============================================================================
@@ -0,0 +1,70 @@
+//==============================================================================
+
+#include <units_matrix.hpp>
+#include <units_si.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  using speed = si::metre_per_second;
+  using acceleration = si::metre_per_second_squared;
+
+  using state = quantity_vector<double, si::metre, speed, acceleration>;
+  using covariance = covariance_matrix<double, si::metre, speed, acceleration>;
+  using transition =
+      quantity_matrix<double, unit_list<si::metre, speed, acceleration>,
+                      unit_list<si::metre, speed, acceleration>>;
+
+  // Constant acceleration over half a second. The off-diagonal elements are
+  // in seconds and seconds squared, and set() converts into them.
+  transition F;
+  for (std::size_t i = 0; i < 3; ++i)
+    F.data()[i * 3 + i] = 1;
+  F.set<0, 1>(quantity_of<si::milli<si::second>>(500.0));
+  F.set<1, 2>(quantity_of<si::second>(0.5));
+  F.set<0, 2>(quantity_of<si::second>(0.5) * quantity_of<si::second>(0.25));
+
+  state const x{quantity_of<si::metre>(0.0), quantity_of<speed>(10.0),
+                quantity_of<acceleration>(2.0)};
+  auto const next = F * x;
+  static_assert(std::is_same_v<decltype(next), state const>);
+
+  bool ok = next.get<0>().get() == 5.25 && next.get<1>().get() == 11.0 &&
+            next.get<2>().get() == 2.0;
+
+  // The covariance step keeps every element in its own unit, and stays
+  // symmetric.
+  covariance P, Q;
+  P.set<0, 0>(quantity_of<si::square_metre>(4.0));
+  P.set<1, 1>(quantity_of<speed>(1.0) * quantity_of<speed>(1.0));
+  P.set<2, 2>(quantity_of<acceleration>(0.5) * quantity_of<acceleration>(1.0));
+  Q.set<2, 2>(quantity_of<acceleration>(0.1) * quantity_of<acceleration>(1.0));
+
+  covariance const predicted = F * P * transpose(F) + Q;
+  static_assert(std::is_same_v<
+                std::remove_const_t<decltype(predicted.get<0, 0>())>,
+                quantity<double, si::square_metre>>);
+
+  // 4 + 0.25 * 1 + 0.015625 * 0.5, and 0.5 * 1 + 0.125 * 0.5 * 0.5.
+  ok = ok && predicted.get<0, 0>().get() == 4.2578125 &&
+       predicted.get<0, 1>().get() == 0.53125 &&
+       predicted.get<1, 0>().get() == predicted.get<0, 1>().get() &&
+       predicted.get<2, 2>().get() == 0.6;
+
+  if (!ok) {
+    std::cerr << "the filter step gave the wrong state or covariance"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << next.get<0>().get() << " m, " << next.get<1>().get() << " m/s"
+            << std::endl;
+}
+
+//==============================================================================
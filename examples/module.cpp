@@ -0,0 +1,28 @@
+//==============================================================================
+
+#include <iostream>
+#include <ratio>
+
+import units.si;
+
+//------------------------------------------------------------------------------
+
+int main() {
+  using namespace units;
+
+  auto x = quantity_of<si::kilo<si::metre>>(4.0);
+  auto y = quantity_of<si::deca<si::metre>>(10.0);
+  auto w = quantity_of<si::second>(10.0);
+
+  auto velocity = unit_cast<si::metre_per_second>((x - y) / w);
+
+  if (velocity.get() != 390.0) {
+    std::cerr << "the imported units gave " << velocity.get() << " m/s"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << velocity.get() << std::endl;
+}
+
+//==============================================================================
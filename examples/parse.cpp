@@ -0,0 +1,64 @@
+//==============================================================================
+
+#include <units_parse.hpp>
+#include <units_si.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <ratio>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using hour = scaled_unit<std::ratio<3600>, si::second>;
+using kilometre_per_hour =
+    derived_unit<si::kilo<si::metre>, units::exp<hour, -1>>;
+
+constexpr auto symbols = make_symbol_table(
+    symbol<si::metre>("m"), symbol<si::kilo<si::metre>>("km"),
+    symbol<si::kilogram>("kg"), symbol<si::second>("s"), symbol<hour>("h"),
+    symbol<si::kelvin>("K"), symbol<si::newton>("N"), symbol<si::joule>("J"),
+    symbol<si::hertz>("Hz"));
+
+// Parsing is constexpr, so a unit's dimension can be checked at compile time.
+static_assert(symbols.parse("kg*m/s^2")->dimension ==
+              dimension_of<si::newton>);
+static_assert(symbols.parse("J / kg / K")->dimension ==
+              dimension_of<si::joule_per_kilogram_kelvin>);
+static_assert(symbols.parse("1/s") == symbols.find("Hz"));
+static_assert(symbols.parse("s^-1") == symbols.find("Hz"));
+
+// Malformed expressions and unknown symbols are rejected, not guessed at.
+static_assert(!symbols.parse(""));
+static_assert(!symbols.parse("m/"));
+static_assert(!symbols.parse("m^"));
+static_assert(!symbols.parse("m**s"));
+static_assert(!symbols.parse("furlong"));
+
+int main() {
+  constexpr std::string_view text[] = {"km/h", "N*m", "m^2/s"};
+  constexpr parsed_unit expected[] = {symbol<kilometre_per_hour>("").unit,
+                                      symbol<si::joule>("").unit,
+                                      {dimension_of<si::square_metre> /
+                                           dimension_of<si::second>,
+                                       1.0}};
+
+  bool ok = true;
+  for (std::size_t i = 0; i < std::size(text); ++i) {
+    auto const u = symbols.parse(text[i]);
+    if (!u || u->dimension != expected[i].dimension ||
+        std::abs(u->scale / expected[i].scale - 1) > 1e-15) {
+      std::cerr << text[i] << " did not parse as expected" << std::endl;
+      ok = false;
+    }
+  }
+
+  auto const kmh = symbols.parse("km/h");
+  std::cout << "1 km/h = " << (kmh ? kmh->scale : 0.0) << " m/s" << std::endl;
+  return ok ? 0 : 1;
+}
+
+//==============================================================================
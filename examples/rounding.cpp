@@ -0,0 +1,97 @@
+//==============================================================================
+
+#include <units_si.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using millimetre = si::milli<si::metre>;
+using q16_16 = fixed_point_unit<si::metre, -16>;
+
+template <rounding R, typename Q>
+bool check(Q const &q, long expected, char const *what) {
+  auto const got = unit_cast<si::metre, R>(q).get();
+  if (got == expected)
+    return true;
+  std::cerr << what << ": got " << got << ", expected " << expected
+            << std::endl;
+  return false;
+}
+
+int main() {
+  bool ok = true;
+
+  // Each of the four modes on the ties and near-ties either side of zero.
+  struct row {
+    long mm, toward_zero, down, up, to_nearest;
+  };
+  row const rows[] = {
+      {1500, 1, 1, 2, 2},     {-1500, -1, -2, -1, -2}, {1499, 1, 1, 2, 1},
+      {-1499, -1, -2, -1, -1}, {2000, 2, 2, 2, 2},
+  };
+
+  for (auto const &r : rows) {
+    auto const q = quantity_of<millimetre>(r.mm);
+    ok &= check<rounding::toward_zero>(q, r.toward_zero, "toward_zero");
+    ok &= check<rounding::down>(q, r.down, "down");
+    ok &= check<rounding::up>(q, r.up, "up");
+    ok &= check<rounding::to_nearest>(q, r.to_nearest, "to_nearest");
+  }
+
+  // Q16.16 metres: whole metres shift up by 16 bits, and back down with
+  // rounding, here from 1.5 m and -1.5 m.
+  auto const three =
+      unit_cast<q16_16>(quantity_of<si::metre>(std::int32_t{3}));
+  if (three.get() != 3 << 16) {
+    std::cerr << "3 m in Q16.16 is " << three.get() << std::endl;
+    ok = false;
+  }
+
+  auto const up = quantity_of<q16_16>(std::int32_t{3 << 15});
+  auto const down = quantity_of<q16_16>(std::int32_t{-(3 << 15)});
+  ok &= check<rounding::down>(up, 1, "Q16.16 down");
+  ok &= check<rounding::to_nearest>(up, 2, "Q16.16 to_nearest");
+  ok &= check<rounding::down>(down, -2, "Q16.16 down, negative");
+  ok &= check<rounding::toward_zero>(down, -1, "Q16.16 toward_zero, negative");
+
+  // Fixed point products are formed in a wider integer and rescaled there:
+  // 3 m * 3 m has 32 fraction bits, which would overflow an int32_t, but
+  // comes back to Q16.16 intact. 1.5 m / 2 m keeps its fraction bits too.
+  using q16_16_area = fixed_point_unit<si::square_metre, -16>;
+  using q16_16_ratio = fixed_point_unit<derived_unit<>, -16>;
+
+  auto const three_m = quantity_of<q16_16>(std::int32_t{3 << 16});
+  auto const area = multiply<q16_16_area>(three_m, three_m);
+  auto const ratio =
+      divide<q16_16_ratio>(up, quantity_of<q16_16>(std::int32_t{2 << 16}));
+  if (area.get() != 9 << 16 || ratio.get() != 3 << 14) {
+    std::cerr << "Q16.16 product " << area.get() << ", quotient "
+              << ratio.get() << std::endl;
+    ok = false;
+  }
+
+  // The rescaled product is rounded as requested, and one that cannot be held
+  // is reported. 21845 / 65536 m is just under a third of a metre.
+  auto const third = quantity_of<q16_16>(std::int32_t{21845});
+  ok &= multiply<q16_16_area, rounding::down>(third, third).get() == 7281;
+  ok &= multiply<q16_16_area, rounding::up>(third, third).get() == 7282;
+
+  try {
+    auto const big = quantity_of<q16_16>(std::int32_t{300 << 16});
+    multiply<q16_16_area>(big, big);
+    std::cerr << "an overflowing product was not reported" << std::endl;
+    ok = false;
+  } catch (std::overflow_error const &) {
+  }
+
+  std::cout << (ok ? "all rounding modes as expected" : "mismatch")
+            << std::endl;
+  return ok ? 0 : 1;
+}
+
+//==============================================================================
@@ -0,0 +1,51 @@
+//==============================================================================
+
+#include <units_si.hpp>
+
+#include <cstdint>
+#include <iostream>
+#include <ratio>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using kilometre = si::kilo<si::metre>;
+
+// 65537 and 65539 are both prime, and past the range of trial division. Their
+// product is the same scale whether it is written at once or in two steps.
+using one_step = scaled_unit<std::ratio<65537ll * 65539ll>, si::metre>;
+using two_steps =
+    scaled_unit<std::ratio<65537>, scaled_unit<std::ratio<65539>, si::metre>>;
+
+static_assert(std::is_same_v<quantity<double, one_step>,
+                             quantity<double, two_steps>>);
+
+int main() {
+  // km^7 has a scale of 10^21, which does not fit in a std::ratio, yet the
+  // quotient below comes back to kilometres exactly.
+  using km7 = derived_unit<units::exp<kilometre, 7>>;
+  using km6 = derived_unit<units::exp<kilometre, 6>>;
+
+  auto const q = quantity_of<km7>(6.0) / quantity_of<km6>(2.0);
+  auto const m = unit_cast<si::metre>(q);
+
+  // 2^-70 m and 2^-68 m differ by a factor of 4, applied as a shift.
+  auto const fine =
+      quantity_of<fixed_point_unit<si::metre, -70>>(std::int64_t{4 << 20});
+  auto const coarse = unit_cast<fixed_point_unit<si::metre, -68>>(fine);
+
+  auto const a = quantity_of<one_step>(std::int64_t{1});
+  auto const b = unit_cast<si::metre>(a);
+
+  if (m.get() != 3000.0 || coarse.get() != 1 << 20 ||
+      b.get() != 65537ll * 65539ll) {
+    std::cerr << "a composed scale was off" << std::endl;
+    return 1;
+  }
+
+  std::cout << m.get() << " m" << std::endl;
+}
+
+//==============================================================================
@@ -0,0 +1,83 @@
+//==============================================================================
+
+#include <units_si.hpp>
+#include <units_statistics.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using millisecond = si::milli<si::second>;
+using latency = quantity<double, millisecond>;
+
+bool close(double a, double b) {
+  return std::abs(a - b) <= 1e-12 * std::abs(b);
+}
+
+int main() {
+  std::vector<latency> xs;
+  for (int i = 1; i <= 1000; ++i)
+    xs.push_back(quantity_of<millisecond>(static_cast<double>(i)));
+  auto const all = std::span<latency const>{xs};
+
+  running_statistics<latency> whole;
+  whole.add(all);
+
+  // The same values split across accumulators, as separate threads would
+  // have them: one value at a time, in batches, and one left empty.
+  running_statistics<latency> a, b, c, empty;
+  for (auto const &x : all.first(300))
+    a.add(x);
+  b.add(all.subspan(300, 400));
+  c.add(all.last(300));
+
+  running_statistics<latency> merged;
+  merged.merge(empty);
+  merged.merge(a);
+  merged.merge(b);
+  merged.merge(empty);
+  merged.merge(c);
+
+  static_assert(std::is_same_v<decltype(merged.variance()),
+                               decltype(latency{0} * latency{0})>);
+
+  // 1..1000 has mean 500.5 and population variance (1000² - 1) / 12.
+  bool ok = merged.count() == 1000 && merged.min().get() == 1.0 &&
+            merged.max().get() == 1000.0 && close(merged.mean().get(), 500.5) &&
+            close(merged.variance().get(), 83333.25) &&
+            close(merged.mean().get(), whole.mean().get()) &&
+            close(merged.variance().get(), whole.variance().get()) &&
+            close(whole.variance().get(), 83333.25);
+
+  // Merged sketches count exactly the same buckets as one sketch of it all,
+  // and each quantile is within the requested 1%.
+  quantile_sketch<latency> one{0.01}, first{0.01}, second{0.01};
+  one.add(all);
+  first.add(all.first(500));
+  second.add(all.last(500));
+  first.merge(second);
+
+  for (double p : {0.0, 0.5, 0.99, 1.0}) {
+    auto const exact = 1.0 + std::floor(p * 999);
+    ok = ok && first.quantile(p) == one.quantile(p) &&
+         std::abs(one.quantile(p).get() - exact) <= 0.01 * exact;
+  }
+
+  if (!ok) {
+    std::cerr << "merged statistics differ from the whole" << std::endl;
+    return 1;
+  }
+
+  std::cout << "mean " << merged.mean().get() << " ms, stddev "
+            << merged.stddev().get() << " ms, median "
+            << first.quantile(0.5).get() << " ms" << std::endl;
+}
+
+//==============================================================================
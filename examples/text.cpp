@@ -0,0 +1,78 @@
+//==============================================================================
+
+#include <units_array.hpp>
+#include <units_parse.hpp>
+#include <units_si.hpp>
+#include <units_text.hpp>
+
+#include <iostream>
+#include <ratio>
+#include <stdexcept>
+#include <string_view>
+
+//------------------------------------------------------------------------------
+
+using namespace units;
+
+using minute = scaled_unit<std::ratio<60>, si::second>;
+
+constexpr auto symbols = make_symbol_table(
+    symbol<si::metre>("m"), symbol<si::kilo<si::metre>>("km"),
+    symbol<si::second>("s"), symbol<minute>("min"), symbol<si::kilogram>("kg"));
+
+using distances = quantity_array<double, si::metre>;
+using durations = quantity_array<double, si::second>;
+
+// Whether reading text into a distance and a duration column fails.
+bool rejected(std::string_view text) {
+  distances d(0);
+  durations t(0);
+  try {
+    read_columns(text, symbols, {}, d, t);
+  } catch (std::runtime_error const &) {
+    return true;
+  }
+  return false;
+}
+
+int main() {
+  distances d(0);
+  durations t(0);
+
+  // Units from the header; a cell may repeat its column's unit.
+  auto rows = read_columns("distance [km], time [min]\n"
+                           "1.5, 2\n"
+                           "\n"
+                           "0.25, 0.5 min\n",
+                           symbols, {',', true}, d, t);
+
+  // Units from the first row, with columns separated by blanks.
+  rows += read_columns("750 m\t90 s\n20 m 1\n", symbols, {' ', false}, d, t);
+
+  double const metres[] = {1500, 250, 750, 20};
+  double const seconds[] = {120, 30, 90, 1};
+
+  bool ok = rows == 4 && d.size() == 4 && t.size() == 4;
+  for (std::size_t i = 0; ok && i < 4; ++i)
+    ok = d[i].get() == metres[i] && t[i].get() == seconds[i];
+
+  if (!ok) {
+    std::cerr << "the columns were not read as expected" << std::endl;
+    return 1;
+  }
+
+  // Unknown units, units of the wrong dimension, a unit that changes within
+  // a column, and rows of the wrong length are all errors.
+  for (auto bad : {"1 furlong, 2 s\n", "1 m, 2 kg\n", "1 km, 1 s\n2 m, 1 s\n",
+                   "1, 2, 3\n", "1\n"}) {
+    if (!rejected(bad)) {
+      std::cerr << "accepted malformed input: " << bad;
+      return 1;
+    }
+  }
+
+  std::cout << rows << " rows, " << d[0].get() << " m in " << t[0].get()
+            << " s first" << std::endl;
+}
+
+//==============================================================================
@@ -0,0 +1,32 @@
+#ifndef BST_UNITS_BITS_CGS_BRIDGES_
+#define BST_UNITS_BITS_CGS_BRIDGES_
+
+#include <ratio>
+
+//==============================================================================
+// Exact values of the SI base units in CGS, and the symbols of the CGS base
+// units, kept apart from the declarations because a module cannot export
+// specializations. They expect units.hpp and
+// the SI and CGS declarations to have been included.
+namespace units {
+
+template <> struct unit_bridge<si::metre> {
+  using type = scaled_unit<std::ratio<100>, cgs::centimetre>;
+};
+
+template <> struct unit_bridge<si::kilogram> {
+  using type = scaled_unit<std::ratio<1000>, cgs::gram>;
+};
+
+template <> struct unit_bridge<si::second> {
+  using type = cgs::second;
+};
+
+template <> inline constexpr std::string_view base_unit_symbol<10> = "cm";
+template <> inline constexpr std::string_view base_unit_symbol<11> = "g";
+template <> inline constexpr std::string_view base_unit_symbol<12> = "s";
+
+} // namespace units
+//==============================================================================
+
+#endif
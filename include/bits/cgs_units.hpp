@@ -0,0 +1,35 @@
+#ifndef BST_UNITS_BITS_CGS_UNITS_
+#define BST_UNITS_BITS_CGS_UNITS_
+
+//==============================================================================
+// The CGS system. Its base units have tags of their own, so that quantities
+// in CGS and SI can be told apart and bridged. This part holds only
+// declarations that can be exported from a module; include units_cgs.hpp
+// rather than this header.
+namespace units {
+
+struct cgs {
+
+  // Base units.
+
+  using centimetre = base_unit<10>;
+  using gram = base_unit<11>;
+  using second = base_unit<12>;
+
+  // Derived units.
+
+  using centimetre_per_second = derived_unit<centimetre, exp<second, -1>>;
+  using gal = derived_unit<centimetre, exp<second, -2>>;
+  using dyne = derived_unit<gram, centimetre, exp<second, -2>>;
+  using erg = derived_unit<gram, exp<centimetre, 2>, exp<second, -2>>;
+  using erg_per_second = derived_unit<erg, exp<second, -1>>;
+  using barye = derived_unit<gram, exp<centimetre, -1>, exp<second, -2>>;
+  using poise = derived_unit<gram, exp<centimetre, -1>, exp<second, -1>>;
+  using stokes = derived_unit<exp<centimetre, 2>, exp<second, -1>>;
+  using kayser = derived_unit<exp<centimetre, -1>>;
+};
+
+} // namespace units
+//==============================================================================
+
+#endif
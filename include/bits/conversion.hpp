@@ -0,0 +1,280 @@
+#ifndef BST_UNITS_BITS_CONVERSION_
+#define BST_UNITS_BITS_CONVERSION_
+
+#include "detail.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+//==============================================================================
+// Conversion of raw values between two scales of the same dimension.
+//
+// The ratio between the scales is known at compile time, so each conversion
+// picks its path up front:
+//
+//   - floating point values are multiplied by a single precomputed factor;
+//   - so are integral values when the ratio involves irrational constants or
+//     does not fit in a std::ratio, with the product rounded as requested;
+//   - integral values use the reduced ratio, and only go through a wider
+//     intermediate when both a multiply and a divide are needed, since that
+//     is the only case where the intermediate can overflow when the result
+//     does not;
+//   - anything else falls back to v * num / den.
+//
+// Integral conversions round as requested, and use shifts in place of
+// multiplies and divides by powers of two where the rounding allows it.
+//
+// apply_checked() performs the same conversion but reports, rather than
+// ignores, a result that cannot be represented in T.
+namespace units {
+
+// How integral conversions that do not come out exact are rounded. The
+// default, like integer division, is toward zero; to_nearest rounds ties away
+// from zero. Floating point conversions are not affected.
+enum class rounding { toward_zero, down, up, to_nearest };
+
+} // namespace units
+
+namespace units::detail {
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+
+template <typename T>
+using widest_t = std::conditional_t<std::is_signed_v<T>, int128_t, uint128_t>;
+#else
+template <typename T>
+using widest_t = std::conditional_t<std::is_signed_v<T>, std::intmax_t,
+                                    std::uintmax_t>;
+#endif
+
+template <typename T>
+using wide_intermediate_t =
+    std::conditional_t<(sizeof(T) < sizeof(std::intmax_t)),
+                       std::conditional_t<std::is_signed_v<T>, std::intmax_t,
+                                          std::uintmax_t>,
+                       widest_t<T>>;
+
+template <typename T, typename W> constexpr bool fits_in(W const &w) {
+  return w >= static_cast<W>(std::numeric_limits<T>::lowest()) &&
+         w <= static_cast<W>(std::numeric_limits<T>::max());
+}
+
+//------------------------------------------------------------------------------
+
+// The ratio between two scales folded into a single multiplier, computed in
+// long double and then rounded once to T.
+template <typename T, typename From, typename To>
+inline constexpr T scale_factor =
+    static_cast<T>(scale_value<typename scale_between<From, To>::type>);
+
+// Round x to an integral value of type W.
+template <rounding R, typename W> constexpr W round_to(long double x) {
+  auto const w = static_cast<W>(x);
+  auto const t = static_cast<long double>(w);
+
+  if constexpr (R == rounding::toward_zero)
+    return w;
+  else if constexpr (R == rounding::down)
+    return t > x ? w - 1 : w;
+  else if constexpr (R == rounding::up)
+    return t < x ? w + 1 : w;
+  else {
+    auto const rem = x - t;
+    if (rem >= 0.5L)
+      return w + 1;
+    if (rem <= -0.5L)
+      return w - 1;
+    return w;
+  }
+}
+
+//------------------------------------------------------------------------------
+
+// The base two logarithm of x if it is a power of two, otherwise -1.
+constexpr int power_of_two_shift(std::intmax_t x) {
+  auto const u = static_cast<std::uintmax_t>(x);
+  return std::has_single_bit(u) ? std::countr_zero(u) : -1;
+}
+
+// Divide q by a positive constant Den, rounding as requested. Dividing by a
+// power of two while rounding down is a single arithmetic shift.
+template <rounding R, std::intmax_t Den, typename W>
+constexpr W divide_rounded(W q) {
+  constexpr int shift = power_of_two_shift(Den);
+  constexpr bool is_signed = W(-1) < W(0);
+
+  if constexpr (R == rounding::down && is_signed && shift >= 0)
+    return q >> shift;
+  else {
+    constexpr auto den = static_cast<W>(Den);
+    auto const quot = q / den;
+    auto const rem = q % den;
+
+    if constexpr (R == rounding::toward_zero)
+      return quot;
+    else if constexpr (R == rounding::down)
+      return rem != 0 && q < 0 ? quot - 1 : quot;
+    else if constexpr (R == rounding::up)
+      return rem != 0 && q > 0 ? quot + 1 : quot;
+    else {
+      auto const twice = rem < 0 ? -(rem * 2) : rem * 2;
+      if (twice < den)
+        return quot;
+      return q < 0 ? quot - 1 : quot + 1;
+    }
+  }
+}
+
+// Multiply q by a positive constant Num, as a shift when Num is a power of
+// two.
+template <std::intmax_t Num, typename W> constexpr W multiply_scaled(W q) {
+  constexpr int shift = power_of_two_shift(Num);
+
+  if constexpr (shift >= 0)
+    return q << shift;
+  else
+    return q * static_cast<W>(Num);
+}
+
+// Divide n by a nonzero d known only at runtime, rounding as requested.
+template <rounding R, typename W> constexpr W divide_rounded_by(W n, W d) {
+  auto const quot = n / d;
+  auto const rem = n % d;
+  bool const negative = (n < 0) != (d < 0);
+
+  if constexpr (R == rounding::toward_zero)
+    return quot;
+  else if constexpr (R == rounding::down)
+    return rem != 0 && negative ? quot - 1 : quot;
+  else if constexpr (R == rounding::up)
+    return rem != 0 && !negative ? quot + 1 : quot;
+  else {
+    auto const twice = rem < 0 ? -(rem * 2) : rem * 2;
+    if (twice < (d < 0 ? -d : d))
+      return quot;
+    return negative ? quot - 1 : quot + 1;
+  }
+}
+
+//------------------------------------------------------------------------------
+
+template <typename T, typename From, typename To,
+          rounding R = rounding::toward_zero>
+struct conversion {
+  using ratio = typename scale_between<From, To>::type;
+
+  static constexpr bool is_exact = is_ratio_scale<ratio>;
+  static constexpr bool is_identity = std::is_same_v<ratio, std::ratio<1, 1>>;
+
+  static constexpr bool is_multiply = [] {
+    if constexpr (is_exact)
+      return ratio::den == 1;
+    else
+      return false;
+  }();
+
+  static constexpr bool is_divide = [] {
+    if constexpr (is_exact)
+      return ratio::num == 1;
+    else
+      return false;
+  }();
+
+  // A divide that can be done in T itself, with no wider intermediate: the
+  // rounding step doubles the remainder, so Den must fit in T twice over.
+  static constexpr bool is_narrow_divide = [] {
+    if constexpr (is_divide && std::is_integral_v<T>)
+      return static_cast<std::uintmax_t>(ratio::den) <=
+             static_cast<std::uintmax_t>(std::numeric_limits<T>::max() / 2);
+    else
+      return false;
+  }();
+
+  static constexpr T apply(T const &v) {
+    if constexpr (is_identity)
+      return v;
+    else if constexpr (std::is_floating_point_v<T>)
+      return v * scale_factor<T, From, To>;
+    else if constexpr (std::is_integral_v<T> && !is_exact)
+      return round_to<R, T>(static_cast<long double>(v) *
+                            scale_value<ratio>);
+    else if constexpr (std::is_integral_v<T>) {
+      if constexpr (is_multiply)
+        return static_cast<T>(v * static_cast<T>(ratio::num));
+      else if constexpr (is_narrow_divide)
+        return divide_rounded<R, ratio::den>(v);
+      else {
+        using wide = wide_intermediate_t<T>;
+
+        auto const q = multiply_scaled<ratio::num>(static_cast<wide>(v));
+        return static_cast<T>(divide_rounded<R, ratio::den>(q));
+      }
+    } else if constexpr (is_exact)
+      return v * ratio::num / ratio::den;
+    else
+      return v * scale_factor<T, From, To>;
+  }
+
+  // Convert v into out, returning false instead if the result overflows T.
+  static constexpr bool apply_checked(T const &v, T &out) {
+    if constexpr (is_identity || !std::numeric_limits<T>::is_specialized) {
+      out = apply(v);
+      return true;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      out = apply(v);
+      return fits_in<T>(out) || !fits_in<T>(v);
+    } else if constexpr (!is_exact) {
+      auto const x = static_cast<long double>(v) * scale_value<ratio>;
+      if (!fits_in<T>(x))
+        return false;
+
+      out = round_to<R, T>(x);
+      return true;
+    } else if constexpr (is_divide) {
+      out = apply(v);
+      return true;
+    } else if constexpr (is_multiply) {
+      if (static_cast<std::uintmax_t>(ratio::num) >
+          static_cast<std::uintmax_t>(std::numeric_limits<T>::max()))
+        return v == 0 ? (out = 0, true) : false;
+
+      constexpr auto num = static_cast<T>(ratio::num);
+      if (v > std::numeric_limits<T>::max() / num ||
+          v < std::numeric_limits<T>::lowest() / num)
+        return false;
+
+      out = v * num;
+      return true;
+    } else {
+      using wide = wide_intermediate_t<T>;
+
+      constexpr auto num = static_cast<wide>(ratio::num);
+      if (static_cast<wide>(v) > std::numeric_limits<wide>::max() / num ||
+          static_cast<wide>(v) < std::numeric_limits<wide>::lowest() / num)
+        return false;
+
+      auto const w = divide_rounded<R, ratio::den>(static_cast<wide>(v) * num);
+      if (!fits_in<T>(w))
+        return false;
+
+      out = static_cast<T>(w);
+      return true;
+    }
+  }
+};
+
+//------------------------------------------------------------------------------
+
+template <typename From, typename To, typename T>
+constexpr T rescale(T const &v) {
+  return conversion<T, From, To>::apply(v);
+}
+
+} // namespace units::detail
+//==============================================================================
+
+#endif
@@ -2,16 +2,18 @@
 #define BST_UNITS_BITS_DETAIL_
 
 #include "meta.hpp"
+#include "scale.hpp"
 #include "../units_fwd.hpp"
 
+#include <array>
+#include <cstddef>
 #include <ratio>
+#include <type_traits>
+#include <utility>
 
 //==============================================================================
 namespace units::detail {
 
-template <typename... Pairs>
-using derived_unit_impl = meta::type_list<Pairs...>;
-
 template <typename Unit, int P> struct unit_power_pair {
   using unit = Unit;
   static const int power = P;
@@ -19,44 +21,96 @@ template <typename Unit, int P> struct unit_power_pair {
 
 //------------------------------------------------------------------------------
 
-template <typename... Params> struct parse_derived_unit;
-
-template <> struct parse_derived_unit<> { using type = derived_unit_impl<>; };
+// Dimensions are canonicalized as values rather than as types: a list of
+// unit_power_pairs is read into a constexpr array of (tag, power) entries,
+// sorted and merged by ordinary constexpr code, and only the final result is
+// turned back into a type_list. This keeps the template instantiation depth
+// proportional to the number of base units instead of quadratic in it.
 
-template <typename Unit, int P, typename... Params>
-struct parse_derived_unit<exp<Unit, P>, Params...> {
-  using type = typename meta::type_list_append<
-      derived_unit_impl<unit_power_pair<Unit, P>>,
-      typename parse_derived_unit<Params...>::type>::type;
+struct tag_power {
+  int tag;
+  int power;
 };
 
-template <typename Param, typename... Params>
-struct parse_derived_unit<Param, Params...> {
-  using type = typename meta::type_list_append<
-      derived_unit_impl<unit_power_pair<Param, 1>>,
-      typename parse_derived_unit<Params...>::type>::type;
+template <std::size_t N> struct dimension {
+  tag_power items[N == 0 ? 1 : N];
+  std::size_t size;
 };
 
-//------------------------------------------------------------------------------
+// A canonical list of unit_power_pairs, with every power scaled by P.
+template <typename List, int P> struct weighted_units;
+
+template <typename... Pairs, int P>
+struct weighted_units<meta::type_list<Pairs...>, P> {
+  static const std::size_t size = sizeof...(Pairs);
 
-template <typename P1, typename P2> struct comp {
-  static const bool value = P1::unit::tag < P2::unit::tag;
+  template <typename Out> static constexpr void append_to(Out &out, std::size_t &n) {
+    ((out[n++] = tag_power{Pairs::unit::tag, Pairs::power * P}), ...);
+  }
 };
 
-template <typename P1, typename P2> struct merge_add {
-  using type = unit_power_pair<typename P1::unit, P1::power + P2::power>;
+// Sort by tag, sum the powers of equal tags, and drop the zero powers.
+template <std::size_t N>
+constexpr auto canonicalize(std::array<tag_power, N> const &in) {
+  dimension<N> out{};
+
+  for (std::size_t i = 0; i < N; ++i) {
+    std::size_t j = 0;
+    while (j < out.size && out.items[j].tag < in[i].tag)
+      ++j;
+
+    if (j < out.size && out.items[j].tag == in[i].tag) {
+      out.items[j].power += in[i].power;
+      continue;
+    }
+
+    for (std::size_t k = out.size; k > j; --k)
+      out.items[k] = out.items[k - 1];
+    out.items[j] = in[i];
+    ++out.size;
+  }
+
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < out.size; ++i)
+    if (out.items[i].power != 0)
+      out.items[kept++] = out.items[i];
+  out.size = kept;
+
+  return out;
+}
+
+template <typename... Weighted> constexpr auto combine_units() {
+  std::array<tag_power, (std::size_t{0} + ... + Weighted::size)> all{};
+  [[maybe_unused]] std::size_t n = 0;
+  (Weighted::append_to(all, n), ...);
+  return canonicalize(all);
+}
+
+template <auto Dim, typename = std::make_index_sequence<Dim.size>>
+struct dimension_to_list;
+
+template <auto Dim, std::size_t... I>
+struct dimension_to_list<Dim, std::index_sequence<I...>> {
+  using type = meta::type_list<
+      unit_power_pair<base_unit<Dim.items[I].tag>, Dim.items[I].power>...>;
 };
 
-template <typename P1, typename P2> struct merge_sub {
-  using type = unit_power_pair<typename P1::unit, P1::power - P2::power>;
+template <typename... Weighted> struct combined_units {
+  using type =
+      typename dimension_to_list<combine_units<Weighted...>()>::type;
 };
 
-template <typename P> struct invert_power {
-  using type = unit_power_pair<typename P::unit, -1 * P::power>;
+//------------------------------------------------------------------------------
+
+// The unit and power of one parameter of a derived_unit.
+template <typename Param> struct derived_param {
+  using unit = Param;
+  static const int power = 1;
 };
 
-template <typename P> struct is_power_zero {
-  static const bool value = P::power == 0;
+template <typename Unit, int P> struct derived_param<exp<Unit, P>> {
+  using unit = Unit;
+  static const int power = P;
 };
 
 //------------------------------------------------------------------------------
@@ -73,62 +127,147 @@ template <typename Scale, typename Unit>
 struct flatten_and_scale<scaled_unit<Scale, Unit>> {
   using base_unit_list = typename flatten_and_scale<Unit>::base_unit_list;
 
-  using ratio =
-      std::ratio_multiply<Scale, typename flatten_and_scale<Unit>::ratio>;
+  using ratio = typename combine_scales<
+      Scale, typename flatten_and_scale<Unit>::ratio, 1>::type;
 };
 
-template <> struct flatten_and_scale<derived_unit_impl<>> {
-  using base_unit_list = meta::type_list<>;
+// An affine unit measures differences exactly like the scaled unit; its
+// offset only matters for points, see get_offset.
+template <typename Offset, typename Scale, typename Unit>
+struct flatten_and_scale<affine_unit<Offset, Scale, Unit>>
+    : flatten_and_scale<scaled_unit<Scale, Unit>> {};
+
+template <typename... Params> struct flatten_and_scale<derived_unit<Params...>> {
+  using base_unit_list = typename combined_units<weighted_units<
+      typename flatten_and_scale<typename derived_param<Params>::unit>::
+          base_unit_list,
+      derived_param<Params>::power>...>::type;
+
+  using ratio = typename scale_product<typename scale_power<
+      typename flatten_and_scale<typename derived_param<Params>::unit>::ratio,
+      derived_param<Params>::power>::type...>::type;
+};
 
-  using ratio = std::ratio<1, 1>;
+//------------------------------------------------------------------------------
+
+template <typename T> struct is_quantity : std::false_type {};
+
+template <typename T, typename S, typename UL>
+struct is_quantity<basic_quantity<T, S, UL>> : std::true_type {};
+
+//------------------------------------------------------------------------------
+
+template <typename Unit> struct get_base_unit_list {
+  using type = typename flatten_and_scale<Unit>::base_unit_list;
 };
 
-template <typename Pair, typename... Pairs>
-struct flatten_and_scale<derived_unit_impl<Pair, Pairs...>> {
-  using pair_units =
-      typename flatten_and_scale<typename Pair::unit>::base_unit_list;
+template <typename Unit> struct get_scale {
+  using type = typename flatten_and_scale<Unit>::ratio;
+};
 
-  template <typename P> struct op {
-    using type = unit_power_pair<typename P::unit, P::power * Pair::power>;
-  };
+// Where the zero of Unit lies, in coherent base units. Only affine units have
+// a non-zero offset.
+template <typename Unit> struct get_offset {
+  using type = std::ratio<0, 1>;
+};
 
-  // Transform and sort Pair's units.
-  using updated_units = typename meta::sort_type_list<
-      comp, typename meta::type_list_map<op, pair_units>::type>::type;
+template <typename Offset, typename Scale, typename Unit>
+struct get_offset<affine_unit<Offset, Scale, Unit>> {
+  static_assert(std::is_same_v<typename get_offset<Unit>::type, std::ratio<0, 1>>,
+                "Affine units cannot be nested");
 
-  // Fetch and sort the remaining items.
-  using rest_of_units = typename meta::sort_type_list<
-      comp, typename flatten_and_scale<
-                derived_unit_impl<Pairs...>>::base_unit_list>::type;
+  using type =
+      typename combine_scales<Offset, typename get_scale<Unit>::type, 1>::type;
 
-  // Merge them together.
-  using base_unit_list = typename meta::type_list_remove_if<
-      is_power_zero,
-      typename meta::type_list_merge_with<comp, merge_add, updated_units,
-                                          rest_of_units>::type>::type;
+  static_assert(is_ratio_scale<type>,
+                "The offset of an affine unit must fit in a std::ratio");
+};
 
-  using ratio = std::ratio_multiply<
-      typename meta::ratio_power<
-          typename flatten_and_scale<typename Pair::unit>::ratio,
-          Pair::power>::type,
-      typename flatten_and_scale<derived_unit_impl<Pairs...>>::ratio>;
+//------------------------------------------------------------------------------
+
+// A base unit's image under its unit_bridge, or the base unit itself if it has
+// no bridge.
+template <typename BaseUnit> struct bridged {
+  using type = BaseUnit;
+};
+
+template <typename BaseUnit>
+  requires requires { typename unit_bridge<BaseUnit>::type; }
+struct bridged<BaseUnit> {
+  using type = typename unit_bridge<BaseUnit>::type;
+};
+
+// A list of base units with every bridged unit replaced by its image.
+template <typename UnitList> struct bridge_units;
+
+template <typename... Pairs>
+struct bridge_units<meta::type_list<Pairs...>>
+    : flatten_and_scale<derived_unit<
+          exp<typename bridged<typename Pairs::unit>::type, Pairs::power>...>> {};
+
+// The scale of a quantity in FromUnits, expressed relative to ToUnits. Units
+// of the same system are used as is; otherwise one side is carried across the
+// bridges into the other's system. Everything is resolved here, so converting
+// between systems is still a single constant factor.
+template <typename FromScale, typename FromUnits, typename ToUnits>
+struct bridged_scale {
+  using forward = bridge_units<FromUnits>;
+  using backward = bridge_units<ToUnits>;
+
+  static constexpr bool is_forward =
+      std::is_same_v<typename forward::base_unit_list, ToUnits>;
+  static constexpr bool is_backward =
+      std::is_same_v<typename backward::base_unit_list, FromUnits>;
+
+  static constexpr bool convertible = is_forward || is_backward;
+
+  using type = std::conditional_t<
+      is_forward, typename combine_scales<FromScale, typename forward::ratio, 1>::type,
+      typename combine_scales<FromScale, typename backward::ratio, -1>::type>;
 };
 
-template <typename... Values> struct flatten_and_scale<derived_unit<Values...>>
-    : flatten_and_scale<typename parse_derived_unit<Values...>::type>
-{
+template <typename FromScale, typename Units>
+struct bridged_scale<FromScale, Units, Units> {
+  static constexpr bool convertible = true;
+
+  using type = FromScale;
 };
 
 //------------------------------------------------------------------------------
 
-template <typename Unit> struct get_base_unit_list {
-  using type = typename flatten_and_scale<Unit>::base_unit_list;
+// The ratio that takes a value expressed in From units to one expressed in To
+// units, where both are scales relative to the same base units.
+template <typename From, typename To> struct scale_between {
+  using type = typename combine_scales<From, To, -1>::type;
 };
 
-template <typename Unit> struct get_scale {
-  using type = typename flatten_and_scale<Unit>::ratio;
+//------------------------------------------------------------------------------
+
+// Result dimensions and scales of the arithmetic operators. These are shared
+// by the scalar operators and anything else that combines quantities.
+
+template <typename UL1, typename UL2> struct multiply_units {
+  using type = typename combined_units<weighted_units<UL1, 1>,
+                                       weighted_units<UL2, 1>>::type;
+};
+
+template <typename UL1, typename UL2> struct divide_units {
+  using type = typename combined_units<weighted_units<UL1, 1>,
+                                       weighted_units<UL2, -1>>::type;
 };
 
+template <typename Scale1, typename Scale2> struct multiply_scales {
+  using type = typename combine_scales<Scale1, Scale2, 1>::type;
+};
+
+template <typename Scale1, typename Scale2> struct divide_scales {
+  using type = typename combine_scales<Scale1, Scale2, -1>::type;
+};
+
+// Addition and subtraction are carried out in the finer of the two scales.
+template <typename Scale1, typename Scale2> struct additive_scale {
+  using type = std::conditional_t<scale_less<Scale1, Scale2>, Scale1, Scale2>;
+};
 
 } // namespace units::detail
 //==============================================================================
@@ -0,0 +1,146 @@
+#ifndef BST_UNITS_BITS_EXPRESSION_
+#define BST_UNITS_BITS_EXPRESSION_
+
+#include "conversion.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+//==============================================================================
+// Lazy element-wise expressions over arrays of quantities.
+//
+// Every node knows the quantity type it produces, which is worked out by the
+// scalar operators at compile time. Indexing a node yields a raw value already
+// in that quantity's scale, so evaluating a whole tree is one loop with all of
+// the scale factors folded into constants.
+namespace units::detail {
+
+template <typename T> struct is_expression_node : std::false_type {};
+
+//------------------------------------------------------------------------------
+
+template <typename Quantity> class array_leaf {
+  Quantity const *vals;
+  std::size_t n;
+
+public:
+  using quantity_type = Quantity;
+  static constexpr bool is_scalar = false;
+
+  constexpr array_leaf(Quantity const *p, std::size_t size)
+      : vals{p}, n{size} {}
+
+  constexpr auto size() const { return n; }
+  constexpr auto operator[](std::size_t i) const { return vals[i].get(); }
+};
+
+template <typename Q>
+struct is_expression_node<array_leaf<Q>> : std::true_type {};
+
+//------------------------------------------------------------------------------
+
+// A single quantity broadcast across every element.
+template <typename Quantity> class scalar_leaf {
+  typename Quantity::value_type val;
+
+public:
+  using quantity_type = Quantity;
+  static constexpr bool is_scalar = true;
+
+  explicit constexpr scalar_leaf(Quantity const &q) : val{q.get()} {}
+
+  constexpr auto operator[](std::size_t) const { return val; }
+};
+
+template <typename Q>
+struct is_expression_node<scalar_leaf<Q>> : std::true_type {};
+
+//------------------------------------------------------------------------------
+
+struct add_op {
+  template <typename Q1, typename Q2>
+  using result = decltype(std::declval<Q1>() + std::declval<Q2>());
+
+  template <typename R, typename Q1, typename Q2, typename V1, typename V2>
+  static constexpr auto apply(V1 a, V2 b) {
+    using rep = typename R::value_type;
+    return rescale<typename Q1::scale, typename R::scale>(static_cast<rep>(a)) +
+           rescale<typename Q2::scale, typename R::scale>(static_cast<rep>(b));
+  }
+};
+
+struct sub_op {
+  template <typename Q1, typename Q2>
+  using result = decltype(std::declval<Q1>() - std::declval<Q2>());
+
+  template <typename R, typename Q1, typename Q2, typename V1, typename V2>
+  static constexpr auto apply(V1 a, V2 b) {
+    using rep = typename R::value_type;
+    return rescale<typename Q1::scale, typename R::scale>(static_cast<rep>(a)) -
+           rescale<typename Q2::scale, typename R::scale>(static_cast<rep>(b));
+  }
+};
+
+struct mul_op {
+  template <typename Q1, typename Q2>
+  using result = decltype(std::declval<Q1>() * std::declval<Q2>());
+
+  template <typename R, typename Q1, typename Q2, typename V1, typename V2>
+  static constexpr auto apply(V1 a, V2 b) {
+    using rep = typename R::value_type;
+    return static_cast<rep>(a) * static_cast<rep>(b);
+  }
+};
+
+struct div_op {
+  template <typename Q1, typename Q2>
+  using result = decltype(std::declval<Q1>() / std::declval<Q2>());
+
+  template <typename R, typename Q1, typename Q2, typename V1, typename V2>
+  static constexpr auto apply(V1 a, V2 b) {
+    using rep = typename R::value_type;
+    return static_cast<rep>(a) / static_cast<rep>(b);
+  }
+};
+
+//------------------------------------------------------------------------------
+
+template <typename Op, typename L, typename R> class binary_expr {
+  L lhs;
+  R rhs;
+
+  using lhs_quantity = typename L::quantity_type;
+  using rhs_quantity = typename R::quantity_type;
+
+public:
+  using quantity_type = typename Op::template result<lhs_quantity, rhs_quantity>;
+  static constexpr bool is_scalar = L::is_scalar && R::is_scalar;
+
+  constexpr binary_expr(L const &l, R const &r) : lhs{l}, rhs{r} {}
+
+  constexpr std::size_t size() const {
+    if constexpr (L::is_scalar)
+      return rhs.size();
+    else if constexpr (R::is_scalar)
+      return lhs.size();
+    else {
+      assert(lhs.size() == rhs.size());
+      return lhs.size();
+    }
+  }
+
+  constexpr auto operator[](std::size_t i) const {
+    return Op::template apply<quantity_type, lhs_quantity, rhs_quantity>(
+        lhs[i], rhs[i]);
+  }
+};
+
+template <typename Op, typename L, typename R>
+struct is_expression_node<binary_expr<Op, L, R>> : std::true_type {};
+
+} // namespace units::detail
+//==============================================================================
+
+#endif
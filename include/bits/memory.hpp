@@ -0,0 +1,49 @@
+#ifndef BST_UNITS_BITS_MEMORY_
+#define BST_UNITS_BITS_MEMORY_
+
+#include <cstddef>
+#include <new>
+
+//==============================================================================
+namespace units {
+
+// The default alignment for quantity storage. One cache line, which is also
+// wide enough for any current vector register.
+inline constexpr std::size_t default_alignment = 64;
+
+//------------------------------------------------------------------------------
+
+template <typename T, std::size_t Align = default_alignment>
+struct aligned_allocator {
+  static_assert(Align >= alignof(T), "Alignment is too small for the type");
+
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = aligned_allocator<U, Align>;
+  };
+
+  constexpr aligned_allocator() noexcept = default;
+
+  template <typename U>
+  constexpr aligned_allocator(aligned_allocator<U, Align> const &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{Align}));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t{Align});
+  }
+
+  template <typename U>
+  constexpr bool operator==(aligned_allocator<U, Align> const &) const noexcept {
+    return true;
+  }
+};
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,456 @@
+#ifndef BST_UNITS_BITS_SCALE_
+#define BST_UNITS_BITS_SCALE_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+//==============================================================================
+// Scales are usually plain std::ratios. Arithmetic on them, however, is done
+// on magnitudes: a sign times a product of integral powers of primes and of
+// irrational constants such as pi, as in
+//
+//   using degree = scaled_unit<irrational_ratio<std::ratio<1, 180>, pi>, radian>;
+//
+// Multiplying, dividing and raising magnitudes to powers only adds exponents,
+// so it is exact and cannot overflow, and pi cancels out of degree / radian.
+// A result that fits in a std::ratio is turned back into one, so most scales
+// keep their usual types; anything else stays a scale_magnitude. Only when a
+// conversion needs an actual number is a scale folded, at compile time and in
+// long double, into a single factor.
+namespace units {
+
+// An irrational constant and the symbol it is printed with.
+struct irrational {
+  long double value;
+  char symbol[8];
+
+  constexpr bool operator==(irrational const &) const = default;
+};
+
+inline constexpr irrational pi{3.141592653589793238462643383279502884L, "π"};
+inline constexpr irrational euler{2.718281828459045235360287471352662498L, "e"};
+
+// A constant raised to an integral power, e.g. irrational_power{pi, -1}.
+struct irrational_power {
+  irrational constant{};
+  int power = 0;
+
+  constexpr irrational_power() = default;
+  constexpr irrational_power(irrational c, int p = 1) : constant{c}, power{p} {}
+
+  constexpr bool operator==(irrational_power const &) const = default;
+};
+
+} // namespace units
+
+namespace units::detail {
+
+inline constexpr std::size_t max_magnitude_factors = 16;
+
+// One factor of a magnitude: a prime, or an irrational constant if prime is
+// zero, raised to an integral power.
+struct magnitude_factor {
+  std::intmax_t prime = 0;
+  irrational constant{};
+  int power = 0;
+
+  constexpr bool operator==(magnitude_factor const &) const = default;
+};
+
+// Primes come first, in increasing order, then constants ordered by value.
+constexpr bool factor_less(magnitude_factor const &a, magnitude_factor const &b) {
+  if ((a.prime == 0) != (b.prime == 0))
+    return a.prime != 0;
+  if (a.prime != 0)
+    return a.prime < b.prime;
+  return a.constant.value < b.constant.value;
+}
+
+constexpr bool same_base(magnitude_factor const &a, magnitude_factor const &b) {
+  return a.prime == b.prime && a.constant == b.constant;
+}
+
+// A canonical magnitude: one entry per base, no zero powers, unused entries
+// left zeroed. A sign of zero is the magnitude of zero.
+struct magnitude {
+  int sign = 1;
+  magnitude_factor items[max_magnitude_factors];
+  std::size_t size = 0;
+
+  constexpr bool operator==(magnitude const &) const = default;
+
+  constexpr void multiply(magnitude_factor f) {
+    if (f.power == 0)
+      return;
+
+    std::size_t j = 0;
+    while (j < size && factor_less(items[j], f))
+      ++j;
+
+    if (j < size && same_base(items[j], f)) {
+      items[j].power += f.power;
+      if (items[j].power == 0) {
+        for (std::size_t k = j; k + 1 < size; ++k)
+          items[k] = items[k + 1];
+        items[--size] = magnitude_factor{};
+      }
+      return;
+    }
+
+    if (size == max_magnitude_factors)
+      throw "units: too many distinct factors in one scale";
+
+    for (std::size_t k = size; k > j; --k)
+      items[k] = items[k - 1];
+    items[j] = f;
+    ++size;
+  }
+
+  constexpr bool is_rational() const {
+    return size == 0 || items[size - 1].prime != 0;
+  }
+};
+
+// Modular arithmetic on 64-bit values, for factoring what trial division
+// leaves over.
+
+constexpr std::uint64_t mul_mod(std::uint64_t a, std::uint64_t b,
+                                std::uint64_t m) {
+#ifdef __SIZEOF_INT128__
+  __extension__ typedef unsigned __int128 wide;
+  return static_cast<std::uint64_t>(static_cast<wide>(a) * b % m);
+#else
+  std::uint64_t r = 0;
+  for (a %= m; b != 0; b >>= 1) {
+    if (b & 1)
+      r = r >= m - a ? r - (m - a) : r + a;
+    a = a >= m - a ? a - (m - a) : a + a;
+  }
+  return r;
+#endif
+}
+
+constexpr std::uint64_t pow_mod(std::uint64_t b, std::uint64_t e,
+                                std::uint64_t m) {
+  std::uint64_t r = 1;
+  for (b %= m; e != 0; e >>= 1) {
+    if (e & 1)
+      r = mul_mod(r, b, m);
+    b = mul_mod(b, b, m);
+  }
+  return r;
+}
+
+// Miller-Rabin; these bases make it exact for every 64-bit n.
+constexpr bool is_prime(std::uint64_t n) {
+  constexpr std::uint64_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+  if (n < 2)
+    return false;
+  for (auto b : bases)
+    if (n % b == 0)
+      return n == b;
+
+  auto d = n - 1;
+  int s = 0;
+  for (; d % 2 == 0; d /= 2)
+    ++s;
+
+  for (auto b : bases) {
+    auto x = pow_mod(b, d, n);
+    if (x == 1 || x == n - 1)
+      continue;
+
+    bool composite = true;
+    for (int i = 1; i < s && composite; ++i) {
+      x = mul_mod(x, x, n);
+      composite = x != n - 1;
+    }
+    if (composite)
+      return false;
+  }
+  return true;
+}
+
+constexpr std::uint64_t gcd(std::uint64_t a, std::uint64_t b) {
+  while (b != 0) {
+    auto const t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// A nontrivial divisor of the odd composite n, by Pollard's rho.
+constexpr std::uint64_t find_divisor(std::uint64_t n) {
+  for (std::uint64_t c = 1;; ++c) {
+    auto step = [&](std::uint64_t x) { return (mul_mod(x, x, n) + c) % n; };
+
+    std::uint64_t x = 2;
+    std::uint64_t y = 2;
+    std::uint64_t d = 1;
+    while (d == 1) {
+      x = step(x);
+      y = step(step(y));
+      d = gcd(x > y ? x - y : y - x, n);
+    }
+    if (d != n)
+      return d;
+  }
+}
+
+constexpr void factor_large_into(magnitude &m, std::uint64_t n, int p) {
+  if (n == 1)
+    return;
+  if (is_prime(n)) {
+    m.multiply(magnitude_factor{static_cast<std::intmax_t>(n), {}, p});
+    return;
+  }
+
+  auto const d = find_divisor(n);
+  factor_large_into(m, d, p);
+  factor_large_into(m, n / d, p);
+}
+
+// Factor n into the magnitude m, raised to power p. Small factors are found by
+// trial division; what is left over after 2^16 has no factor below that, and
+// is split by Pollard's rho, so every factor that ends up in m is prime and
+// equal scales always have equal magnitudes.
+constexpr void factor_into(magnitude &m, std::intmax_t n, int p) {
+  if (n < 0) {
+    if (p % 2 != 0)
+      m.sign = -m.sign;
+    n = -n;
+  }
+
+  for (std::intmax_t f = 2; f <= 65536 && f * f <= n; ++f) {
+    int e = 0;
+    while (n % f == 0) {
+      n /= f;
+      ++e;
+    }
+    m.multiply(magnitude_factor{f, {}, e * p});
+  }
+
+  factor_large_into(m, static_cast<std::uint64_t>(n), p);
+}
+
+template <std::intmax_t Num, std::intmax_t Den>
+constexpr magnitude magnitude_of_ratio() {
+  magnitude m;
+  if constexpr (Num == 0)
+    m.sign = 0;
+  else {
+    factor_into(m, Num, 1);
+    factor_into(m, Den, -1);
+  }
+  return m;
+}
+
+// a * b^p.
+constexpr magnitude multiply_magnitudes(magnitude a, magnitude const &b, int p) {
+  if (b.sign == 0 && p != 0) {
+    if (p < 0)
+      throw "units: division by a zero scale";
+    return magnitude{0, {}, 0};
+  }
+  if (a.sign == 0)
+    return a;
+
+  if (b.sign < 0 && p % 2 != 0)
+    a.sign = -a.sign;
+  for (std::size_t i = 0; i < b.size; ++i) {
+    auto f = b.items[i];
+    f.power *= p;
+    a.multiply(f);
+  }
+  return a;
+}
+
+//------------------------------------------------------------------------------
+
+// A magnitude as a std::ratio's numerator and denominator, if it is rational
+// and they fit.
+struct ratio_fit {
+  bool fits = false;
+  std::intmax_t num = 0;
+  std::intmax_t den = 1;
+};
+
+constexpr ratio_fit fit_ratio(magnitude const &m) {
+  if (m.sign == 0)
+    return {true, 0, 1};
+  if (!m.is_rational())
+    return {};
+
+  constexpr auto max = std::numeric_limits<std::intmax_t>::max();
+  std::intmax_t num = 1;
+  std::intmax_t den = 1;
+
+  for (std::size_t i = 0; i < m.size; ++i) {
+    auto &part = m.items[i].power > 0 ? num : den;
+    auto const n = m.items[i].power > 0 ? m.items[i].power : -m.items[i].power;
+    for (int k = 0; k < n; ++k) {
+      if (part > max / m.items[i].prime)
+        return {};
+      part *= m.items[i].prime;
+    }
+  }
+  return {true, m.sign * num, den};
+}
+
+// A scale that does not fit in a std::ratio.
+template <magnitude M> struct scale_magnitude {
+  static constexpr magnitude value = M;
+};
+
+template <typename Scale> struct magnitude_of;
+
+template <std::intmax_t Num, std::intmax_t Den>
+struct magnitude_of<std::ratio<Num, Den>> {
+  static constexpr magnitude value = magnitude_of_ratio<Num, Den>();
+};
+
+template <magnitude M> struct magnitude_of<scale_magnitude<M>> {
+  static constexpr magnitude value = M;
+};
+
+template <magnitude M> struct make_scale {
+  static constexpr ratio_fit fit = fit_ratio(M);
+
+  using type = std::conditional_t<fit.fits, std::ratio<fit.num, fit.den>,
+                                  scale_magnitude<M>>;
+};
+
+// Whether Scale is an ordinary std::ratio, whose num and den can be used.
+template <typename Scale> inline constexpr bool is_ratio_scale = false;
+
+template <std::intmax_t Num, std::intmax_t Den>
+inline constexpr bool is_ratio_scale<std::ratio<Num, Den>> = true;
+
+//------------------------------------------------------------------------------
+
+// Scale1 * Scale2^P.
+template <typename Scale1, typename Scale2, int P> struct combine_scales {
+  using type = typename make_scale<multiply_magnitudes(
+      magnitude_of<Scale1>::value, magnitude_of<Scale2>::value, P)>::type;
+};
+
+// Products of ratios that cannot overflow are left to std::ratio_multiply,
+// which is cheaper than factoring.
+template <std::intmax_t N1, std::intmax_t D1, std::intmax_t N2, std::intmax_t D2>
+  requires(N1 >= -(1 << 30) && N1 <= (1 << 30) && D1 <= (1 << 30) &&
+           N2 >= -(1 << 30) && N2 <= (1 << 30) && D2 <= (1 << 30))
+struct combine_scales<std::ratio<N1, D1>, std::ratio<N2, D2>, 1> {
+  using type = typename std::ratio_multiply<std::ratio<N1, D1>,
+                                            std::ratio<N2, D2>>::type;
+};
+
+template <typename Scale, int P> struct scale_power {
+  using type = typename combine_scales<std::ratio<1, 1>, Scale, P>::type;
+};
+
+template <typename Scale> struct scale_term {
+  using type = Scale;
+};
+
+template <typename S1, typename S2>
+constexpr auto operator*(scale_term<S1>, scale_term<S2>) {
+  return scale_term<typename combine_scales<S1, S2, 1>::type>{};
+}
+
+// The product of any number of scales, as a single fold.
+template <typename... Scales> struct scale_product {
+  using type = typename decltype((scale_term<std::ratio<1, 1>>{} * ... *
+                                  scale_term<Scales>{}))::type;
+};
+
+// The N-th root of a magnitude, split into the largest part with integral
+// exponents and the remainder, whose root has to be taken numerically.
+struct magnitude_root {
+  magnitude root;
+  magnitude remainder;
+};
+
+constexpr magnitude_root root_of(magnitude const &m, int n) {
+  if (m.sign < 0)
+    throw "units: root of a negative scale";
+
+  magnitude_root out{magnitude{m.sign, {}, 0}, magnitude{m.sign, {}, 0}};
+  for (std::size_t i = 0; i < m.size; ++i) {
+    auto const e = m.items[i].power;
+    auto const q = e >= 0 ? e / n : -((-e + n - 1) / n);
+
+    auto f = m.items[i];
+    f.power = q;
+    out.root.multiply(f);
+    f.power = e - q * n;
+    out.remainder.multiply(f);
+  }
+  if (m.sign == 0)
+    out.remainder.sign = 0;
+  return out;
+}
+
+//------------------------------------------------------------------------------
+
+constexpr long double magnitude_value(magnitude const &m) {
+  long double v = m.sign;
+
+  for (std::size_t i = 0; i < m.size; ++i) {
+    auto const &f = m.items[i];
+    auto const base = f.prime != 0 ? static_cast<long double>(f.prime)
+                                   : f.constant.value;
+    for (int k = 0; k < f.power; ++k)
+      v *= base;
+    for (int k = 0; k > f.power; --k)
+      v /= base;
+  }
+  return v;
+}
+
+// The numeric value of a scale, in long double.
+template <typename Scale>
+inline constexpr long double scale_value =
+    magnitude_value(magnitude_of<Scale>::value);
+
+template <std::intmax_t Num, std::intmax_t Den>
+inline constexpr long double scale_value<std::ratio<Num, Den>> =
+    static_cast<long double>(Num) / static_cast<long double>(Den);
+
+// Whether Scale1 is finer than Scale2: exact for ratios, by value otherwise.
+template <typename Scale1, typename Scale2>
+inline constexpr bool scale_less = [] {
+  if constexpr (is_ratio_scale<Scale1> && is_ratio_scale<Scale2>)
+    return std::ratio_less_v<Scale1, Scale2>;
+  else
+    return scale_value<Scale1> < scale_value<Scale2>;
+}();
+
+} // namespace units::detail
+
+//------------------------------------------------------------------------------
+
+namespace units {
+
+namespace detail {
+template <typename Ratio, irrational_power... Factors>
+constexpr magnitude irrational_magnitude() {
+  auto m = magnitude_of<typename Ratio::type>::value;
+  (m.multiply(magnitude_factor{0, Factors.constant, Factors.power}), ...);
+  return m;
+}
+} // namespace detail
+
+// Ratio multiplied by each of Factors, for use as the scale of a scaled_unit.
+template <typename Ratio, irrational_power... Factors>
+using irrational_ratio = typename detail::make_scale<
+    detail::irrational_magnitude<Ratio, Factors...>()>::type;
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef BST_UNITS_BITS_SI_TRAITS_
+#define BST_UNITS_BITS_SI_TRAITS_
+
+//==============================================================================
+// Specializations for the SI system, kept apart from its declarations because
+// a module cannot export them. They expect units.hpp and si_units.hpp to have
+// been included.
+
+// Quantities of time convert to and from std::chrono::duration.
+template <> struct units::is_second<units::si::second> {
+  static constexpr bool value = true;
+};
+
+// Symbols of the base units, as printed by units_format.hpp.
+template <> inline constexpr std::string_view units::base_unit_symbol<0> = "s";
+template <> inline constexpr std::string_view units::base_unit_symbol<1> = "m";
+template <> inline constexpr std::string_view units::base_unit_symbol<2> = "kg";
+template <> inline constexpr std::string_view units::base_unit_symbol<3> = "K";
+template <> inline constexpr std::string_view units::base_unit_symbol<4> = "A";
+template <> inline constexpr std::string_view units::base_unit_symbol<5> = "mol";
+template <> inline constexpr std::string_view units::base_unit_symbol<6> = "cd";
+
+//==============================================================================
+
+#endif
@@ -3,11 +3,20 @@
 
 //==============================================================================
 
+#include "bits/conversion.hpp"
 #include "bits/detail.hpp"
 #include "bits/meta.hpp"
 #include "units_fwd.hpp"
 
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <ratio>
+#include <span>
+#include <stdexcept>
 #include <type_traits>
 
 //==============================================================================
@@ -15,6 +24,62 @@ namespace units {
 
 //------------------------------------------------------------------------------
 
+namespace detail {
+
+// Anything shaped like std::chrono::duration. Matching the shape rather than
+// the type keeps <chrono> out of this header.
+template <typename D>
+concept duration_like = requires(D const &d) {
+  typename D::rep;
+  { D::period::num } -> std::convertible_to<std::intmax_t>;
+  { D::period::den } -> std::convertible_to<std::intmax_t>;
+  { d.count() } -> std::same_as<typename D::rep>;
+};
+
+// Whether a list of base units is time, in seconds, and nothing else. This is
+// a class template underneath, rather than a partially specialized variable
+// template, so that the is_second lookup also sees specializations made in
+// another module.
+template <typename UnitList> struct time_units : std::false_type {};
+
+template <int Tag>
+struct time_units<meta::type_list<unit_power_pair<base_unit<Tag>, 1>>>
+    : std::bool_constant<is_second<base_unit<Tag>>::value> {};
+
+template <typename UnitList>
+inline constexpr bool is_time_units = time_units<UnitList>::value;
+
+// Whether a value converts between two scales without losing anything: into
+// a floating point value, or by a whole multiple between integral ones.
+template <typename FromRep, typename FromScale, typename ToRep, typename ToScale>
+inline constexpr bool is_lossless_conversion = [] {
+  using ratio = typename scale_between<FromScale, ToScale>::type;
+
+  if constexpr (std::is_floating_point_v<ToRep>)
+    return true;
+  else if constexpr (std::is_floating_point_v<FromRep> ||
+                     !is_ratio_scale<ratio>)
+    return false;
+  else
+    return ratio::den == 1;
+}();
+
+// Durations convert implicitly exactly when std::chrono would convert them
+// implicitly, which is when nothing is lost.
+template <typename FromRep, typename FromScale, typename ToRep, typename ToScale>
+inline constexpr bool is_lossless_duration_conversion =
+    is_lossless_conversion<FromRep, FromScale, ToRep, ToScale>;
+
+// The element type of a span of quantities, const or not. The batched
+// functions take std::span<Q, N> constrained by this rather than spelling out
+// the quantity, so that spans of any extent and constness deduce.
+template <typename Q>
+concept quantity_element = is_quantity<std::remove_const_t<Q>>::value;
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
 template <typename T, typename Scale, typename UnitList> class basic_quantity {
   T val;
 
@@ -29,24 +94,88 @@ public:
 
   explicit constexpr basic_quantity(value_type const &v) : val{v} {}
 
+  // From a std::chrono::duration, for quantities of time.
+  template <detail::duration_like D>
+    requires detail::is_time_units<UnitList>
+  constexpr explicit(!detail::is_lossless_duration_conversion<
+                     typename D::rep, typename D::period, T, Scale>)
+      basic_quantity(D const &d)
+      : val{static_cast<T>(
+            detail::conversion<std::common_type_t<typename D::rep, T>,
+                               typename D::period, Scale>::apply(d.count()))} {}
+
   constexpr auto get() const { return val; }
 
   template <typename U, typename S, typename UL>
   explicit constexpr operator basic_quantity<U, S, UL>() const {
     using other_type = basic_quantity<U, S, UL>;
 
-    static_assert(convertible_with<other_type>, "Units are not convertible");
+    using from_scale = detail::bridged_scale<scale, base_units, UL>;
+
+    static_assert(from_scale::convertible, "Units are not convertible");
 
-    using scale_to_base = scale;
-    using scale_from_base = typename meta::recip<S>::type;
-    using scale_to_other = std::ratio_multiply<scale_to_base, scale_from_base>;
+    using rep = std::common_type_t<T, U>;
 
-    return other_type{val * scale_to_other::num / scale_to_other::den};
+    return other_type{static_cast<U>(
+        detail::conversion<rep, typename from_scale::type, S>::apply(
+            static_cast<rep>(val)))};
+  }
+
+  // To a std::chrono::duration, for quantities of time.
+  template <detail::duration_like D>
+    requires detail::is_time_units<UnitList>
+  constexpr explicit(!detail::is_lossless_duration_conversion<
+                     T, Scale, typename D::rep, typename D::period>)
+  operator D() const {
+    using rep = typename D::rep;
+    return D{static_cast<rep>(
+        detail::conversion<std::common_type_t<T, rep>, Scale,
+                           typename D::period>::apply(val))};
   }
 
   explicit constexpr operator value_type() const { return val; }
+
+  // Compound assignment keeps this quantity's type: the right hand side is
+  // converted into this scale, so an accumulator never changes type.
+
+  template <typename U, typename S, typename UL>
+  constexpr basic_quantity &operator+=(basic_quantity<U, S, UL> const &other) {
+    static_assert(convertible_with<basic_quantity<U, S, UL>>,
+                  "Units are not compatible for addition");
+    val += static_cast<basic_quantity>(other).get();
+    return *this;
+  }
+
+  template <typename U, typename S, typename UL>
+  constexpr basic_quantity &operator-=(basic_quantity<U, S, UL> const &other) {
+    static_assert(convertible_with<basic_quantity<U, S, UL>>,
+                  "Units are not compatible for subtraction");
+    val -= static_cast<basic_quantity>(other).get();
+    return *this;
+  }
+
+  constexpr basic_quantity &operator*=(value_type const &s) {
+    val *= s;
+    return *this;
+  }
+
+  constexpr basic_quantity &operator/=(value_type const &s) {
+    val /= s;
+    return *this;
+  }
 };
 
+// A quantity carries nothing at runtime but its value, so it can be passed in
+// registers and copied as freely as the underlying type.
+namespace detail {
+using probe_quantity = basic_quantity<double, std::ratio<1, 1>, meta::type_list<>>;
+
+static_assert(sizeof(probe_quantity) == sizeof(double));
+static_assert(alignof(probe_quantity) == alignof(double));
+static_assert(std::is_trivially_copyable_v<probe_quantity>);
+static_assert(std::is_standard_layout_v<probe_quantity>);
+} // namespace detail
+
 //------------------------------------------------------------------------------
 
 template <typename T1, typename Scale1, typename UL1, typename T2,
@@ -59,7 +188,7 @@ constexpr auto operator+(basic_quantity<T1, Scale1, UL1> const &v1,
   static_assert(value_1::template convertible_with<value_2>,
                 "Units are not compatible for addition");
 
-  if constexpr (std::ratio_less_v<Scale1, Scale2>)
+  if constexpr (detail::scale_less<Scale1, Scale2>)
     return value_1{v1.get() + static_cast<value_1>(v2).get()};
   else
     return value_2{static_cast<value_2>(v1).get() + v2.get()};
@@ -77,7 +206,7 @@ constexpr auto operator-(basic_quantity<T1, Scale1, UL1> const &v1,
   static_assert(value_1::template convertible_with<value_2>,
                 "Units are not compatible for subtraction");
 
-  if constexpr (std::ratio_less_v<Scale1, Scale2>)
+  if constexpr (detail::scale_less<Scale1, Scale2>)
     return value_1{v1.get() - static_cast<value_1>(v2).get()};
   else
     return value_2{static_cast<value_2>(v1).get() - v2.get()};
@@ -85,47 +214,108 @@ constexpr auto operator-(basic_quantity<T1, Scale1, UL1> const &v1,
 
 //------------------------------------------------------------------------------
 
+// Integral products are formed in a wider integer and then narrowed, so one
+// that does not fit wraps rather than overflowing. Fixed point values, whose
+// products need rescaling, are multiplied with multiply<To> below.
 template <typename T1, typename Scale1, typename UL1, typename T2,
           typename Scale2, typename UL2>
 constexpr auto operator*(basic_quantity<T1, Scale1, UL1> const &v1,
                          basic_quantity<T2, Scale2, UL2> const &v2) {
-  using unit_list = typename meta::type_list_remove_if<
-      detail::is_power_zero,
-      typename meta::type_list_merge_with<detail::comp, detail::merge_add, UL1,
-                                          UL2>::type>::type;
-
+  using unit_list = typename detail::multiply_units<UL1, UL2>::type;
   using value_type = std::common_type_t<T1, T2>;
+  using scale = typename detail::multiply_scales<Scale1, Scale2>::type;
+
+  if constexpr (std::is_integral_v<value_type>) {
+    using wide = detail::wide_intermediate_t<value_type>;
+    return basic_quantity<value_type, scale, unit_list>(static_cast<value_type>(
+        static_cast<wide>(v1.get()) * static_cast<wide>(v2.get())));
+  } else
+    return basic_quantity<value_type, scale, unit_list>(
+        static_cast<value_type>(v1.get()) * static_cast<value_type>(v2.get()));
+}
 
-  using scale_to_base = Scale1;
-  using scale_from_base = typename meta::recip<Scale2>::type;
-  using scale = std::ratio_multiply<scale_to_base, scale_from_base>;
+//------------------------------------------------------------------------------
+
+template <typename T1, typename Scale1, typename UL1, typename T2,
+          typename Scale2, typename UL2>
+constexpr auto operator/(basic_quantity<T1, Scale1, UL1> const &v1,
+                         basic_quantity<T2, Scale2, UL2> const &v2) {
+  using unit_list = typename detail::divide_units<UL1, UL2>::type;
+  using value_type = std::common_type_t<T1, T2>;
+  using scale = typename detail::divide_scales<Scale1, Scale2>::type;
 
   return basic_quantity<value_type, scale, unit_list>(
-      static_cast<value_type>(v1.get()) * static_cast<value_type>(v2.get()));
+      static_cast<value_type>(v1.get()) / static_cast<value_type>(v2.get()));
 }
 
 //------------------------------------------------------------------------------
 
+// Scaling by a plain number leaves the unit alone.
+
+template <typename T, typename Scale, typename UL, typename U>
+  requires std::is_arithmetic_v<U>
+constexpr auto operator*(basic_quantity<T, Scale, UL> const &v, U const &s) {
+  using value_type = std::common_type_t<T, U>;
+  return basic_quantity<value_type, Scale, UL>{static_cast<value_type>(v.get()) *
+                                               static_cast<value_type>(s)};
+}
+
+template <typename U, typename T, typename Scale, typename UL>
+  requires std::is_arithmetic_v<U>
+constexpr auto operator*(U const &s, basic_quantity<T, Scale, UL> const &v) {
+  return v * s;
+}
+
+template <typename T, typename Scale, typename UL, typename U>
+  requires std::is_arithmetic_v<U>
+constexpr auto operator/(basic_quantity<T, Scale, UL> const &v, U const &s) {
+  using value_type = std::common_type_t<T, U>;
+  return basic_quantity<value_type, Scale, UL>{static_cast<value_type>(v.get()) /
+                                               static_cast<value_type>(s)};
+}
+
+//------------------------------------------------------------------------------
+
+// Comparisons convert both operands into their common value type, at the
+// finer of the two scales, so that neither side is truncated and the result
+// does not depend on the order of the operands.
+
+namespace detail {
+
+template <typename Q1, typename Q2>
+using comparison_type = basic_quantity<
+    std::common_type_t<typename Q1::value_type, typename Q2::value_type>,
+    typename additive_scale<typename Q1::scale, typename Q2::scale>::type,
+    typename Q1::base_units>;
+
+} // namespace detail
+
 template <typename T1, typename Scale1, typename UL1, typename T2,
           typename Scale2, typename UL2>
-constexpr auto operator/(basic_quantity<T1, Scale1, UL1> const &v1,
-                         basic_quantity<T2, Scale2, UL2> const &v2) {
-  using inverted_units =
-      typename meta::type_list_map<detail::invert_power, UL2>::type;
+constexpr bool operator==(basic_quantity<T1, Scale1, UL1> const &v1,
+                          basic_quantity<T2, Scale2, UL2> const &v2) {
+  using value_1 = basic_quantity<T1, Scale1, UL1>;
+  using value_2 = basic_quantity<T2, Scale2, UL2>;
 
-  using unit_list = typename meta::type_list_remove_if<
-      detail::is_power_zero,
-      typename meta::type_list_merge_with<detail::comp, detail::merge_add, UL1,
-                                          inverted_units>::type>::type;
+  static_assert(value_1::template convertible_with<value_2>,
+                "Units are not compatible for comparison");
 
-  using value_type = std::common_type_t<T1, T2>;
+  using common = detail::comparison_type<value_1, value_2>;
+  return static_cast<common>(v1).get() == static_cast<common>(v2).get();
+}
 
-  using scale_to_base = Scale1;
-  using scale_from_base = typename meta::recip<Scale2>::type;
-  using scale = std::ratio_multiply<scale_to_base, scale_from_base>;
+template <typename T1, typename Scale1, typename UL1, typename T2,
+          typename Scale2, typename UL2>
+constexpr auto operator<=>(basic_quantity<T1, Scale1, UL1> const &v1,
+                           basic_quantity<T2, Scale2, UL2> const &v2) {
+  using value_1 = basic_quantity<T1, Scale1, UL1>;
+  using value_2 = basic_quantity<T2, Scale2, UL2>;
 
-  return basic_quantity<value_type, scale, unit_list>(
-      static_cast<value_type>(v1.get()) / static_cast<value_type>(v2.get()));
+  static_assert(value_1::template convertible_with<value_2>,
+                "Units are not compatible for comparison");
+
+  using common = detail::comparison_type<value_1, value_2>;
+  return static_cast<common>(v1).get() <=> static_cast<common>(v2).get();
 }
 
 //------------------------------------------------------------------------------
@@ -136,10 +326,176 @@ template <typename To, typename T> constexpr auto unit_cast(T const &x) {
 
 //------------------------------------------------------------------------------
 
+// As unit_cast, but with integral values rounded as requested rather than
+// truncated, e.g. unit_cast<metre, rounding::to_nearest>(x).
+template <typename To, rounding R, typename T>
+constexpr auto unit_cast(T const &x) {
+  using value_type = typename T::value_type;
+  using to_type = quantity<value_type, To>;
+
+  using from_scale = detail::bridged_scale<typename T::scale, typename T::base_units,
+                                           typename to_type::base_units>;
+
+  static_assert(from_scale::convertible, "Units are not convertible");
+
+  return to_type{detail::conversion<value_type, typename from_scale::type,
+                                    typename to_type::scale, R>::apply(x.get())};
+}
+
+//------------------------------------------------------------------------------
+
+// As unit_cast, but throws std::overflow_error if the converted value cannot
+// be represented in the quantity's value type.
+template <typename To, typename T> constexpr auto checked_unit_cast(T const &x) {
+  using value_type = typename T::value_type;
+  using to_type = quantity<value_type, To>;
+
+  using from_scale = detail::bridged_scale<typename T::scale, typename T::base_units,
+                                           typename to_type::base_units>;
+
+  static_assert(from_scale::convertible, "Units are not convertible");
+
+  value_type out{};
+  if (!detail::conversion<value_type, typename from_scale::type,
+                          typename to_type::scale>::apply_checked(x.get(), out))
+    throw std::overflow_error{"units::checked_unit_cast: value out of range"};
+
+  return to_type{out};
+}
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+// a * b or a / b with the result in unit To. Integral values are combined in
+// a wider integer, where the scale is folded into the numerator and
+// denominator, and only the final result is rounded and narrowed.
+template <typename To, rounding R, bool Divide, typename Q1, typename Q2>
+constexpr auto combine_into(Q1 const &a, Q2 const &b) {
+  using value_type =
+      std::common_type_t<typename Q1::value_type, typename Q2::value_type>;
+  using to_type = quantity<value_type, To>;
+
+  using unit_list = std::conditional_t<
+      Divide, divide_units<typename Q1::base_units, typename Q2::base_units>,
+      multiply_units<typename Q1::base_units, typename Q2::base_units>>;
+  using scale = std::conditional_t<
+      Divide, divide_scales<typename Q1::scale, typename Q2::scale>,
+      multiply_scales<typename Q1::scale, typename Q2::scale>>;
+
+  static_assert(
+      std::is_same_v<typename unit_list::type, typename to_type::base_units>,
+      "Units are not convertible");
+
+  if constexpr (!std::is_integral_v<value_type>) {
+    auto const x = static_cast<value_type>(a.get());
+    auto const y = static_cast<value_type>(b.get());
+    return to_type{
+        conversion<value_type, typename scale::type, typename to_type::scale,
+                   R>::apply(Divide ? x / y : x * y)};
+  } else {
+    using ratio =
+        typename scale_between<typename scale::type,
+                               typename to_type::scale>::type;
+    static_assert(is_ratio_scale<ratio>,
+                  "Integral products need a rational scale");
+
+    using wide = wide_intermediate_t<value_type>;
+    constexpr auto num = static_cast<wide>(ratio::num);
+    constexpr auto den = static_cast<wide>(ratio::den);
+
+    auto const x = static_cast<wide>(a.get());
+    auto const y = static_cast<wide>(b.get());
+
+    wide w;
+    if constexpr (Divide) {
+      if (x > std::numeric_limits<wide>::max() / num ||
+          x < std::numeric_limits<wide>::lowest() / num ||
+          y > std::numeric_limits<wide>::max() / den ||
+          y < std::numeric_limits<wide>::lowest() / den)
+        throw std::overflow_error{"units::divide: value out of range"};
+      w = divide_rounded_by<R>(x * num, y * den);
+    } else {
+      auto const p = x * y;
+      if (p > std::numeric_limits<wide>::max() / num ||
+          p < std::numeric_limits<wide>::lowest() / num)
+        throw std::overflow_error{"units::multiply: value out of range"};
+      w = divide_rounded<R, ratio::den>(multiply_scaled<ratio::num>(p));
+    }
+
+    if (!fits_in<value_type>(w))
+      throw std::overflow_error{Divide ? "units::divide: value out of range"
+                                       : "units::multiply: value out of range"};
+    return to_type{static_cast<value_type>(w)};
+  }
+}
+
+} // namespace detail
+
+// a * b, with the result in unit To, rounded as requested. Integral values
+// are multiplied in a wider integer (128 bits where the compiler supports it)
+// and rescaled there, so this is how fixed point values are multiplied:
+// multiply<fixed_point_unit<square_metre, -16>>(a, b) for two Q16.16 lengths.
+// Throws std::overflow_error if the result does not fit the value type.
+template <typename To, rounding R = rounding::toward_zero, typename Q1,
+          typename Q2>
+  requires detail::is_quantity<Q1>::value && detail::is_quantity<Q2>::value
+constexpr auto multiply(Q1 const &a, Q2 const &b) {
+  return detail::combine_into<To, R, false>(a, b);
+}
+
+// a / b, with the result in unit To, as for multiply. The dividend is
+// rescaled before the division, so e.g. a quotient of two Q16.16 values keeps
+// all sixteen fraction bits.
+template <typename To, rounding R = rounding::toward_zero, typename Q1,
+          typename Q2>
+  requires detail::is_quantity<Q1>::value && detail::is_quantity<Q2>::value
+constexpr auto divide(Q1 const &a, Q2 const &b) {
+  return detail::combine_into<To, R, true>(a, b);
+}
+
+//------------------------------------------------------------------------------
+
+// Convert a contiguous range of quantities in one pass. The scale is folded
+// into a single factor up front, so the loop body is one multiply per element
+// for floating point types. to.size() must be at least from.size().
+template <typename To, detail::quantity_element Q, std::size_t N, std::size_t M>
+constexpr void
+unit_cast(std::span<Q, N> from,
+          std::span<quantity<typename Q::value_type, To>, M> to) {
+  using to_type = quantity<typename Q::value_type, To>;
+  using from_scale =
+      detail::bridged_scale<typename Q::scale, typename Q::base_units,
+                            typename to_type::base_units>;
+
+  static_assert(from_scale::convertible, "Units are not convertible");
+
+  assert(to.size() >= from.size());
+
+  using to_scale = typename to_type::scale;
+
+  auto const n = from.size();
+  for (std::size_t i = 0; i < n; ++i)
+    to[i] = to_type{
+        detail::rescale<typename from_scale::type, to_scale>(from[i].get())};
+}
+
+//------------------------------------------------------------------------------
+
 template <typename Unit, typename T> constexpr auto quantity_of(T const &x) {
   return quantity<T, Unit>{x};
 }
 
+//------------------------------------------------------------------------------
+
+// Unit scaled by Radix^Exponent. A quantity of such a unit with an integral
+// value type is a fixed point number whose exponent lives in the type, e.g.
+// quantity<std::int32_t, fixed_point_unit<metre, -16>> holds metres in Q16.16.
+// Conversions between binary fixed point units reduce to shifts.
+template <typename Unit, int Exponent, int Radix = 2>
+using fixed_point_unit = scaled_unit<
+    typename detail::scale_power<std::ratio<Radix, 1>, Exponent>::type, Unit>;
+
 } // namespace units
 //==============================================================================
 
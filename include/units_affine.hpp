@@ -0,0 +1,266 @@
+#ifndef BST_UNITS_AFFINE_HPP_
+#define BST_UNITS_AFFINE_HPP_
+
+//==============================================================================
+
+#include "bits/conversion.hpp"
+#include "units.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <numeric>
+#include <ratio>
+#include <span>
+#include <type_traits>
+
+//==============================================================================
+// Points on an affine scale, such as temperatures in degrees Celsius.
+//
+// A value v of affine_unit<Offset, Scale, Unit> stands for v * Scale + Offset
+// in Unit, e.g.
+//
+//   using celsius = affine_unit<std::ratio<27315, 100>, std::ratio<1>, kelvin>;
+//
+// As a plain quantity, quantity<T, celsius>, it measures a difference, and
+// behaves exactly like the scaled unit. A quantity_point<T, celsius> is a
+// position on the scale: subtracting two points gives a difference, and a
+// difference can be added to or subtracted from a point. Plain units may be
+// used for points too, with an offset of zero.
+namespace units {
+
+//------------------------------------------------------------------------------
+
+template <typename T, typename Scale, typename Offset, typename UnitList>
+class basic_quantity_point;
+
+template <typename T, typename Unit>
+using quantity_point =
+    basic_quantity_point<T, typename detail::get_scale<Unit>::type,
+                         typename detail::get_offset<Unit>::type,
+                         typename detail::get_base_unit_list<Unit>::type>;
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+// Moving a point from one affine scale to another is v * a + b, with a and b
+// worked out here as exact ratios.
+template <typename T, typename FromScale, typename FromOffset, typename ToScale,
+          typename ToOffset>
+struct point_conversion {
+  using a = typename combine_scales<FromScale, ToScale, -1>::type;
+  using b = typename combine_scales<std::ratio_subtract<FromOffset, ToOffset>,
+                                    ToScale, -1>::type;
+
+  static constexpr T apply(T const &v) {
+    if constexpr (std::is_same_v<b, std::ratio<0, 1>>)
+      return conversion<T, FromScale, ToScale>::apply(v);
+    else if constexpr (std::is_floating_point_v<T>) {
+      constexpr T scale = static_cast<T>(scale_value<a>);
+      constexpr T offset = static_cast<T>(scale_value<b>);
+      if constexpr (std::is_same_v<a, std::ratio<1, 1>>)
+        return v + offset;
+      else
+        return v * scale + offset;
+    } else if constexpr (std::is_integral_v<T>) {
+      static_assert(is_ratio_scale<a> && is_ratio_scale<b>,
+                    "Integral points need rational scales");
+
+      // (v * A + B) / D, over the common denominator of a and b.
+      using wide = wide_intermediate_t<T>;
+      constexpr std::intmax_t d = std::lcm(a::den, b::den);
+      constexpr auto scale = static_cast<wide>(a::num * (d / a::den));
+      constexpr auto offset = static_cast<wide>(b::num * (d / b::den));
+      return static_cast<T>((static_cast<wide>(v) * scale + offset) /
+                            static_cast<wide>(d));
+    } else
+      return v * a::num / a::den + T(b::num) / T(b::den);
+  }
+};
+
+// The type two points are compared in: their common value type, on the scale
+// and offset of the finer of the two.
+template <typename P1, typename P2>
+using point_comparison_type = basic_quantity_point<
+    std::common_type_t<typename P1::value_type, typename P2::value_type>,
+    std::conditional_t<scale_less<typename P1::scale, typename P2::scale>,
+                       typename P1::scale, typename P2::scale>,
+    std::conditional_t<scale_less<typename P1::scale, typename P2::scale>,
+                       typename P1::offset, typename P2::offset>,
+    typename P1::base_units>;
+
+template <typename T> struct is_quantity_point : std::false_type {};
+
+template <typename T, typename S, typename O, typename UL>
+struct is_quantity_point<basic_quantity_point<T, S, O, UL>> : std::true_type {};
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+template <typename T, typename Scale, typename Offset, typename UnitList>
+class basic_quantity_point {
+  T val;
+
+public:
+  using value_type = T;
+  using scale = Scale;
+  using offset = Offset;
+  using base_units = UnitList;
+
+  // The type of the difference between two such points.
+  using difference_type = basic_quantity<T, Scale, UnitList>;
+
+  template <typename Other>
+  static constexpr auto convertible_with =
+      std::is_same_v<base_units, typename Other::base_units>;
+
+  explicit constexpr basic_quantity_point(value_type const &v) : val{v} {}
+
+  constexpr auto get() const { return val; }
+
+  template <typename U, typename S, typename O, typename UL>
+  explicit constexpr operator basic_quantity_point<U, S, O, UL>() const {
+    using other_type = basic_quantity_point<U, S, O, UL>;
+
+    static_assert(convertible_with<other_type>, "Units are not convertible");
+
+    using rep = std::common_type_t<T, U>;
+
+    return other_type{static_cast<U>(
+        detail::point_conversion<rep, scale, offset, S, O>::apply(
+            static_cast<rep>(val)))};
+  }
+
+  template <typename U, typename S, typename UL>
+  constexpr basic_quantity_point &
+  operator+=(basic_quantity<U, S, UL> const &d) {
+    val += static_cast<difference_type>(d).get();
+    return *this;
+  }
+
+  template <typename U, typename S, typename UL>
+  constexpr basic_quantity_point &
+  operator-=(basic_quantity<U, S, UL> const &d) {
+    val -= static_cast<difference_type>(d).get();
+    return *this;
+  }
+};
+
+//------------------------------------------------------------------------------
+
+// point - point is the difference between them, in the scale of the first and
+// the common value type of the two.
+template <typename T1, typename S1, typename O1, typename UL1, typename T2,
+          typename S2, typename O2, typename UL2>
+constexpr auto operator-(basic_quantity_point<T1, S1, O1, UL1> const &p1,
+                         basic_quantity_point<T2, S2, O2, UL2> const &p2) {
+  using point_1 = basic_quantity_point<T1, S1, O1, UL1>;
+  using point_2 = basic_quantity_point<T2, S2, O2, UL2>;
+
+  static_assert(point_1::template convertible_with<point_2>,
+                "Units are not compatible for subtraction");
+
+  using rep = std::common_type_t<T1, T2>;
+  using common = basic_quantity_point<rep, S1, O1, UL1>;
+
+  return basic_quantity<rep, S1, UL1>{static_cast<rep>(p1.get()) -
+                                      static_cast<common>(p2).get()};
+}
+
+// point +/- difference is another point on the same scale.
+template <typename T, typename S, typename O, typename UL, typename U,
+          typename S2, typename UL2>
+constexpr auto operator+(basic_quantity_point<T, S, O, UL> p,
+                         basic_quantity<U, S2, UL2> const &d) {
+  static_assert(std::is_same_v<UL, UL2>, "Units are not compatible for addition");
+  return p += d;
+}
+
+template <typename U, typename S2, typename UL2, typename T, typename S,
+          typename O, typename UL>
+constexpr auto operator+(basic_quantity<U, S2, UL2> const &d,
+                         basic_quantity_point<T, S, O, UL> p) {
+  static_assert(std::is_same_v<UL, UL2>, "Units are not compatible for addition");
+  return p += d;
+}
+
+template <typename T, typename S, typename O, typename UL, typename U,
+          typename S2, typename UL2>
+constexpr auto operator-(basic_quantity_point<T, S, O, UL> p,
+                         basic_quantity<U, S2, UL2> const &d) {
+  static_assert(std::is_same_v<UL, UL2>,
+                "Units are not compatible for subtraction");
+  return p -= d;
+}
+
+//------------------------------------------------------------------------------
+
+// Like quantities, points are compared in their common value type, on the
+// finer of the two scales.
+template <typename T1, typename S1, typename O1, typename UL1, typename T2,
+          typename S2, typename O2, typename UL2>
+constexpr bool operator==(basic_quantity_point<T1, S1, O1, UL1> const &p1,
+                          basic_quantity_point<T2, S2, O2, UL2> const &p2) {
+  using common = detail::point_comparison_type<
+      basic_quantity_point<T1, S1, O1, UL1>,
+      basic_quantity_point<T2, S2, O2, UL2>>;
+  return static_cast<common>(p1).get() == static_cast<common>(p2).get();
+}
+
+template <typename T1, typename S1, typename O1, typename UL1, typename T2,
+          typename S2, typename O2, typename UL2>
+constexpr auto operator<=>(basic_quantity_point<T1, S1, O1, UL1> const &p1,
+                           basic_quantity_point<T2, S2, O2, UL2> const &p2) {
+  using common = detail::point_comparison_type<
+      basic_quantity_point<T1, S1, O1, UL1>,
+      basic_quantity_point<T2, S2, O2, UL2>>;
+  return static_cast<common>(p1).get() <=> static_cast<common>(p2).get();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename Unit, typename T>
+constexpr auto quantity_point_of(T const &x) {
+  return quantity_point<T, Unit>{x};
+}
+
+template <typename To, typename T, typename S, typename O, typename UL>
+constexpr auto unit_cast(basic_quantity_point<T, S, O, UL> const &p) {
+  return static_cast<quantity_point<T, To>>(p);
+}
+
+// Convert a contiguous range of points. Scale and offset are folded into two
+// constants, so each element costs one multiply-add. to.size() must be at
+// least from.size().
+template <typename To, typename P, std::size_t N, std::size_t M>
+  requires detail::is_quantity_point<std::remove_const_t<P>>::value
+constexpr void
+unit_cast(std::span<P, N> from,
+          std::span<quantity_point<typename P::value_type, To>, M> to) {
+  using from_type = std::remove_const_t<P>;
+  using to_type = quantity_point<typename P::value_type, To>;
+
+  static_assert(from_type::template convertible_with<to_type>,
+                "Units are not convertible");
+
+  assert(to.size() >= from.size());
+
+  using convert =
+      detail::point_conversion<typename from_type::value_type,
+                               typename from_type::scale,
+                               typename from_type::offset,
+                               typename to_type::scale,
+                               typename to_type::offset>;
+
+  auto const n = from.size();
+  for (std::size_t i = 0; i < n; ++i)
+    to[i] = to_type{convert::apply(from[i].get())};
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef BST_UNITS_ALGORITHM_HPP_
+#define BST_UNITS_ALGORITHM_HPP_
+
+//==============================================================================
+
+#include "units.hpp"
+
+#include <cassert>
+#include <execution>
+#include <functional>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+// How reductions add up their terms. Compensated summation (Neumaier's
+// variant of Kahan summation) carries the rounding error of each addition
+// along with the sum, at the cost of a few extra operations per term. It
+// relies on strict floating point semantics, so it is defeated by options
+// such as -ffast-math.
+enum class summation { plain, compensated };
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename R>
+concept quantity_range =
+    std::ranges::random_access_range<R> &&
+    is_quantity<std::remove_cvref_t<std::ranges::range_value_t<R>>>::value;
+
+template <typename P>
+concept execution_policy = std::is_execution_policy_v<std::remove_cvref_t<P>>;
+
+// A running sum and the rounding error it has accumulated.
+template <typename T> struct compensated_sum {
+  T sum{};
+  T carry{};
+
+  static constexpr T magnitude(T x) { return x < T{} ? -x : x; }
+
+  constexpr void add(T x) {
+    T const t = sum + x;
+    if (magnitude(sum) >= magnitude(x))
+      carry += (sum - t) + x;
+    else
+      carry += (x - t) + sum;
+    sum = t;
+  }
+
+  constexpr T value() const { return sum + carry; }
+
+  friend constexpr compensated_sum operator+(compensated_sum a,
+                                             compensated_sum const &b) {
+    a.add(b.sum);
+    a.carry += b.carry;
+    return a;
+  }
+};
+
+// Sum transform(*it) over [first, last) as raw values of type T.
+template <summation Mode, typename T, typename Policy, typename It,
+          typename Transform>
+T sum_values(Policy &&policy, It first, It last, Transform transform) {
+  if constexpr (Mode == summation::compensated) {
+    return std::transform_reduce(
+               std::forward<Policy>(policy), first, last,
+               compensated_sum<T>{}, std::plus<>{},
+               [&](auto const &x) {
+                 return compensated_sum<T>{static_cast<T>(transform(x)), T{}};
+               })
+        .value();
+  } else {
+    return std::transform_reduce(std::forward<Policy>(policy), first, last, T{},
+                                 std::plus<>{}, [&](auto const &x) {
+                                   return static_cast<T>(transform(x));
+                                 });
+  }
+}
+
+// Sum transform(*it1, *it2) over [first1, last1) and the range at first2.
+template <summation Mode, typename T, typename Policy, typename It1,
+          typename It2, typename Transform>
+T sum_values(Policy &&policy, It1 first1, It1 last1, It2 first2,
+             Transform transform) {
+  if constexpr (Mode == summation::compensated) {
+    return std::transform_reduce(
+               std::forward<Policy>(policy), first1, last1, first2,
+               compensated_sum<T>{}, std::plus<>{},
+               [&](auto const &x, auto const &y) {
+                 return compensated_sum<T>{static_cast<T>(transform(x, y)),
+                                           T{}};
+               })
+        .value();
+  } else {
+    return std::transform_reduce(std::forward<Policy>(policy), first1, last1,
+                                 first2, T{}, std::plus<>{},
+                                 [&](auto const &x, auto const &y) {
+                                   return static_cast<T>(transform(x, y));
+                                 });
+  }
+}
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+// The sum of a range of quantities, in their unit.
+template <summation Mode = summation::plain, typename Policy, typename Range>
+  requires detail::execution_policy<Policy> && detail::quantity_range<Range>
+auto reduce(Policy &&policy, Range const &values) {
+  using quantity_type = std::ranges::range_value_t<Range>;
+  using value_type = typename quantity_type::value_type;
+
+  return quantity_type{detail::sum_values<Mode, value_type>(
+      std::forward<Policy>(policy), std::ranges::begin(values),
+      std::ranges::end(values), [](auto const &q) { return q.get(); })};
+}
+
+template <summation Mode = summation::plain, typename Range>
+  requires detail::quantity_range<Range>
+auto reduce(Range const &values) {
+  return units::reduce<Mode>(std::execution::seq, values);
+}
+
+//------------------------------------------------------------------------------
+
+// The sum of transform(q) over a range, where transform yields quantities. The
+// result has whatever unit transform produces, e.g. the square of the input
+// unit for [](auto q) { return q * q; }.
+template <summation Mode = summation::plain, typename Policy, typename Range,
+          typename Transform>
+  requires detail::execution_policy<Policy> && detail::quantity_range<Range>
+auto transform_reduce(Policy &&policy, Range const &values,
+                      Transform transform) {
+  using quantity_type = std::invoke_result_t<
+      Transform &, std::ranges::range_reference_t<Range const>>;
+  using value_type = typename quantity_type::value_type;
+
+  return quantity_type{detail::sum_values<Mode, value_type>(
+      std::forward<Policy>(policy), std::ranges::begin(values),
+      std::ranges::end(values),
+      [&](auto const &q) { return transform(q).get(); })};
+}
+
+template <summation Mode = summation::plain, typename Range,
+          typename Transform>
+  requires detail::quantity_range<Range>
+auto transform_reduce(Range const &values, Transform transform) {
+  return units::transform_reduce<Mode>(std::execution::seq, values,
+                                       std::move(transform));
+}
+
+//------------------------------------------------------------------------------
+
+// The sum of the element-wise products of two ranges of equal length, e.g.
+// force and distance giving energy. The result unit is worked out by
+// operator*, once, at compile time.
+template <summation Mode = summation::plain, typename Policy, typename Range1,
+          typename Range2>
+  requires detail::execution_policy<Policy> &&
+           detail::quantity_range<Range1> && detail::quantity_range<Range2>
+auto inner_product(Policy &&policy, Range1 const &a, Range2 const &b) {
+  using quantity_type =
+      decltype(std::declval<std::ranges::range_value_t<Range1>>() *
+               std::declval<std::ranges::range_value_t<Range2>>());
+  using value_type = typename quantity_type::value_type;
+
+  assert(std::ranges::size(a) == std::ranges::size(b));
+
+  return quantity_type{detail::sum_values<Mode, value_type>(
+      std::forward<Policy>(policy), std::ranges::begin(a), std::ranges::end(a),
+      std::ranges::begin(b),
+      [](auto const &x, auto const &y) { return (x * y).get(); })};
+}
+
+template <summation Mode = summation::plain, typename Range1, typename Range2>
+  requires detail::quantity_range<Range1> && detail::quantity_range<Range2>
+auto inner_product(Range1 const &a, Range2 const &b) {
+  return units::inner_product<Mode>(std::execution::seq, a, b);
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef BST_UNITS_ARRAY_HPP_
+#define BST_UNITS_ARRAY_HPP_
+
+//==============================================================================
+
+#include "bits/expression.hpp"
+#include "bits/memory.hpp"
+#include "units.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+// A contiguous column of quantities that all share one unit. The unit lives in
+// the type, so the storage is nothing but the values themselves, laid out in a
+// single buffer obtained from Allocator.
+template <typename T, typename Scale, typename UnitList,
+          typename Allocator =
+              aligned_allocator<basic_quantity<T, Scale, UnitList>>>
+class basic_quantity_array {
+public:
+  using value_type = T;
+  using scale = Scale;
+  using base_units = UnitList;
+  using quantity_type = basic_quantity<T, Scale, UnitList>;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+private:
+  std::vector<quantity_type, allocator_type> vals;
+
+public:
+  explicit basic_quantity_array(size_type n,
+                                allocator_type const &alloc = allocator_type{})
+      : vals(n, quantity_type{value_type{}}, alloc) {}
+
+  basic_quantity_array(size_type n, quantity_type const &q,
+                       allocator_type const &alloc = allocator_type{})
+      : vals(n, q, alloc) {}
+
+  basic_quantity_array(std::span<quantity_type const> qs,
+                       allocator_type const &alloc = allocator_type{})
+      : vals(qs.begin(), qs.end(), alloc) {}
+
+  auto size() const { return vals.size(); }
+  auto empty() const { return vals.empty(); }
+
+  auto data() { return vals.data(); }
+  auto data() const { return vals.data(); }
+
+  auto begin() { return vals.data(); }
+  auto begin() const { return vals.data(); }
+  auto end() { return vals.data() + vals.size(); }
+  auto end() const { return vals.data() + vals.size(); }
+
+  auto &operator[](size_type i) { return vals[i]; }
+  auto const &operator[](size_type i) const { return vals[i]; }
+
+  auto get_allocator() const { return vals.get_allocator(); }
+
+  void reserve(size_type n) { vals.reserve(n); }
+  void clear() { vals.clear(); }
+  void push_back(quantity_type const &q) { vals.push_back(q); }
+
+  // Evaluate an expression into a new array. The conversion is implicit only
+  // when the expression already produces this array's quantity type.
+  template <typename Expr>
+    requires detail::is_expression_node<Expr>::value
+  explicit(!std::is_same_v<typename Expr::quantity_type, quantity_type>)
+      basic_quantity_array(Expr const &e,
+                           allocator_type const &alloc = allocator_type{})
+      : vals(e.size(), quantity_type{value_type{}}, alloc) {
+    assign(e);
+  }
+
+  template <typename Expr>
+    requires detail::is_expression_node<Expr>::value
+  basic_quantity_array &operator=(Expr const &e) {
+    if (e.size() != vals.size())
+      vals.resize(e.size(), quantity_type{value_type{}});
+    assign(e);
+    return *this;
+  }
+
+private:
+  template <typename Expr> void assign(Expr const &e) {
+    using expr_quantity = typename Expr::quantity_type;
+    using expr_scale =
+        detail::bridged_scale<typename expr_quantity::scale,
+                              typename expr_quantity::base_units, base_units>;
+
+    static_assert(expr_scale::convertible, "Units are not convertible");
+
+    auto const n = vals.size();
+    for (std::size_t i = 0; i < n; ++i)
+      vals[i] = quantity_type{detail::rescale<typename expr_scale::type, scale>(
+          static_cast<value_type>(e[i]))};
+  }
+};
+
+template <typename T, typename Unit,
+          typename Allocator = aligned_allocator<quantity<T, Unit>>>
+using quantity_array =
+    basic_quantity_array<T, typename detail::get_scale<Unit>::type,
+                         typename detail::get_base_unit_list<Unit>::type,
+                         Allocator>;
+
+namespace detail {
+
+// An array of Quantity whose allocator is rebound from Alloc.
+template <typename Quantity, typename Alloc>
+using array_of = basic_quantity_array<
+    typename Quantity::value_type, typename Quantity::scale,
+    typename Quantity::base_units,
+    typename std::allocator_traits<Alloc>::template rebind_alloc<Quantity>>;
+
+template <typename T> struct is_quantity_array : std::false_type {};
+
+template <typename T, typename S, typename UL, typename A>
+struct is_quantity_array<basic_quantity_array<T, S, UL, A>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_array_operand =
+    is_quantity_array<T>::value || is_expression_node<T>::value;
+
+// Array operators kick in when at least one side is an array or an
+// expression; the other side may be a scalar quantity, which is broadcast.
+template <typename L, typename R>
+inline constexpr bool array_operands =
+    (is_array_operand<L> || is_array_operand<R>)&&(
+        is_array_operand<L> || is_quantity<L>::value) &&
+    (is_array_operand<R> || is_quantity<R>::value);
+
+template <typename T> constexpr auto as_expr(T const &x) {
+  if constexpr (is_quantity_array<T>::value)
+    return array_leaf<typename T::quantity_type>{x.data(), x.size()};
+  else if constexpr (is_quantity<T>::value)
+    return scalar_leaf<T>{x};
+  else
+    return x;
+}
+
+template <typename Op, typename L, typename R>
+constexpr auto make_expr(L const &l, R const &r) {
+  using lhs = decltype(as_expr(l));
+  using rhs = decltype(as_expr(r));
+  return binary_expr<Op, lhs, rhs>{as_expr(l), as_expr(r)};
+}
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+// The array operators build expression trees rather than arrays, so that an
+// expression such as (a * b + c) / d is evaluated in a single pass, without
+// temporaries, when it is assigned to an array. Expressions refer to their
+// operands, and must not outlive them.
+
+template <typename L, typename R>
+  requires detail::array_operands<L, R>
+constexpr auto operator+(L const &l, R const &r) {
+  return detail::make_expr<detail::add_op>(l, r);
+}
+
+template <typename L, typename R>
+  requires detail::array_operands<L, R>
+constexpr auto operator-(L const &l, R const &r) {
+  return detail::make_expr<detail::sub_op>(l, r);
+}
+
+template <typename L, typename R>
+  requires detail::array_operands<L, R>
+constexpr auto operator*(L const &l, R const &r) {
+  return detail::make_expr<detail::mul_op>(l, r);
+}
+
+template <typename L, typename R>
+  requires detail::array_operands<L, R>
+constexpr auto operator/(L const &l, R const &r) {
+  return detail::make_expr<detail::div_op>(l, r);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename To, typename T, typename S, typename UL, typename A>
+auto unit_cast(basic_quantity_array<T, S, UL, A> const &x) {
+  using to_type = quantity<T, To>;
+
+  detail::array_of<to_type, A> result(x.size(), x.get_allocator());
+  unit_cast<To>(std::span<basic_quantity<T, S, UL> const>{x},
+                std::span<to_type>{result});
+  return result;
+}
+
+template <typename To, typename Expr>
+  requires detail::is_expression_node<Expr>::value
+auto unit_cast(Expr const &e) {
+  using rep = typename Expr::quantity_type::value_type;
+  return quantity_array<rep, To>{e};
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
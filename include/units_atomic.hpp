@@ -0,0 +1,253 @@
+#ifndef BST_UNITS_ATOMIC_HPP_
+#define BST_UNITS_ATOMIC_HPP_
+
+//==============================================================================
+
+#include "bits/memory.hpp"
+#include "units.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+// A quantity that can be shared between threads: a std::atomic of the value
+// type, with the unit in the type. Quantities of other scales are converted
+// into this one before the atomic operation, by a factor folded at compile
+// time, so the operation itself is the same instruction as on the raw atomic.
+template <typename T, typename Scale, typename UnitList>
+class basic_atomic_quantity {
+public:
+  using value_type = T;
+  using scale = Scale;
+  using base_units = UnitList;
+  using quantity_type = basic_quantity<T, Scale, UnitList>;
+
+  static constexpr bool is_always_lock_free =
+      std::atomic<T>::is_always_lock_free;
+
+private:
+  std::atomic<T> val;
+
+  // Only conversions that lose nothing are done here, so that no part of an
+  // update is silently dropped: adding millimetres to an integral count of
+  // metres does not compile. Round first with unit_cast<Unit, rounding>.
+  template <typename Q> static constexpr T convert(Q const &q) {
+    static_assert(detail::is_quantity<Q>::value, "Not a quantity");
+    static_assert(detail::is_lossless_conversion<typename Q::value_type,
+                                                 typename Q::scale, T, Scale>,
+                  "Conversion into this atomic quantity would truncate");
+    return static_cast<quantity_type>(q).get();
+  }
+
+public:
+  constexpr basic_atomic_quantity() noexcept : val{T{}} {}
+
+  template <typename Q>
+    requires detail::is_quantity<Q>::value
+  constexpr basic_atomic_quantity(Q const &q) noexcept : val{convert(q)} {}
+
+  basic_atomic_quantity(basic_atomic_quantity const &) = delete;
+  basic_atomic_quantity &operator=(basic_atomic_quantity const &) = delete;
+
+  bool is_lock_free() const noexcept { return val.is_lock_free(); }
+
+  quantity_type
+  load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return quantity_type{val.load(order)};
+  }
+
+  template <typename Q>
+  void store(Q const &q,
+             std::memory_order order = std::memory_order_seq_cst) noexcept {
+    val.store(convert(q), order);
+  }
+
+  template <typename Q>
+  quantity_type
+  exchange(Q const &q,
+           std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return quantity_type{val.exchange(convert(q), order)};
+  }
+
+  // Both return the value held before the operation.
+
+  template <typename Q>
+  quantity_type
+  fetch_add(Q const &q,
+            std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return quantity_type{val.fetch_add(convert(q), order)};
+  }
+
+  template <typename Q>
+  quantity_type
+  fetch_sub(Q const &q,
+            std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return quantity_type{val.fetch_sub(convert(q), order)};
+  }
+
+  // As for std::atomic, expected is updated to the current value when the
+  // exchange fails. The desired value may be in any convertible scale.
+
+  template <typename Q>
+  bool compare_exchange_weak(
+      quantity_type &expected, Q const &desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    auto v = expected.get();
+    auto const ok = val.compare_exchange_weak(v, convert(desired), order);
+    expected = quantity_type{v};
+    return ok;
+  }
+
+  template <typename Q>
+  bool compare_exchange_strong(
+      quantity_type &expected, Q const &desired,
+      std::memory_order order = std::memory_order_seq_cst) noexcept {
+    auto v = expected.get();
+    auto const ok = val.compare_exchange_strong(v, convert(desired), order);
+    expected = quantity_type{v};
+    return ok;
+  }
+
+  template <typename Q>
+  bool compare_exchange_weak(quantity_type &expected, Q const &desired,
+                             std::memory_order success,
+                             std::memory_order failure) noexcept {
+    auto v = expected.get();
+    auto const ok =
+        val.compare_exchange_weak(v, convert(desired), success, failure);
+    expected = quantity_type{v};
+    return ok;
+  }
+
+  template <typename Q>
+  bool compare_exchange_strong(quantity_type &expected, Q const &desired,
+                               std::memory_order success,
+                               std::memory_order failure) noexcept {
+    auto v = expected.get();
+    auto const ok =
+        val.compare_exchange_strong(v, convert(desired), success, failure);
+    expected = quantity_type{v};
+    return ok;
+  }
+
+  operator quantity_type() const noexcept { return load(); }
+
+  template <typename Q> quantity_type operator+=(Q const &q) noexcept {
+    auto const v = convert(q);
+    return quantity_type{val.fetch_add(v) + v};
+  }
+
+  template <typename Q> quantity_type operator-=(Q const &q) noexcept {
+    auto const v = convert(q);
+    return quantity_type{val.fetch_sub(v) - v};
+  }
+};
+
+template <typename T, typename Unit>
+using atomic_quantity =
+    basic_atomic_quantity<T, typename detail::get_scale<Unit>::type,
+                          typename detail::get_base_unit_list<Unit>::type>;
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+// A small number fixed for each thread, handed out in the order the threads
+// first ask for one. Threads that run at the same time mostly get distinct
+// numbers, which is what spreading them over shards needs.
+inline std::size_t thread_shard_index() noexcept {
+  static std::atomic<std::size_t> next{0};
+  thread_local std::size_t const index =
+      next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+} // namespace detail
+
+// A counter or gauge for heavily contended updates. The value is split over
+// Shards atomics, each on its own cache line, and each thread adds into its
+// own shard, so threads on different cores do not pass the same line back and
+// forth. Updates are relaxed by default; load sums the shards, and is exact
+// once the updating threads are done, but is not a snapshot while they run.
+template <typename T, typename Scale, typename UnitList,
+          std::size_t Shards = 16>
+class basic_sharded_atomic_quantity {
+  static_assert(Shards > 0, "At least one shard is needed");
+
+public:
+  using value_type = T;
+  using scale = Scale;
+  using base_units = UnitList;
+  using quantity_type = basic_quantity<T, Scale, UnitList>;
+
+  static constexpr std::size_t shard_count = Shards;
+
+private:
+  struct alignas(default_alignment) shard {
+    basic_atomic_quantity<T, Scale, UnitList> value;
+  };
+
+  shard shards[Shards];
+
+  auto &local() noexcept {
+    return shards[detail::thread_shard_index() % Shards].value;
+  }
+
+public:
+  basic_sharded_atomic_quantity() noexcept = default;
+
+  basic_sharded_atomic_quantity(basic_sharded_atomic_quantity const &) =
+      delete;
+  basic_sharded_atomic_quantity &
+  operator=(basic_sharded_atomic_quantity const &) = delete;
+
+  template <typename Q>
+  void add(Q const &q,
+           std::memory_order order = std::memory_order_relaxed) noexcept {
+    local().fetch_add(q, order);
+  }
+
+  template <typename Q>
+  void sub(Q const &q,
+           std::memory_order order = std::memory_order_relaxed) noexcept {
+    local().fetch_sub(q, order);
+  }
+
+  quantity_type
+  load(std::memory_order order = std::memory_order_relaxed) const noexcept {
+    T sum{};
+    for (auto const &s : shards)
+      sum += s.value.load(order).get();
+    return quantity_type{sum};
+  }
+
+  // Set the value to zero, returning what it was. Updates made concurrently
+  // are either counted in the result or left in the counter, never lost.
+  quantity_type
+  reset(std::memory_order order = std::memory_order_relaxed) noexcept {
+    T sum{};
+    for (auto &s : shards)
+      sum += s.value.exchange(quantity_type{T{}}, order).get();
+    return quantity_type{sum};
+  }
+
+  operator quantity_type() const noexcept { return load(); }
+
+  template <typename Q> void operator+=(Q const &q) noexcept { add(q); }
+  template <typename Q> void operator-=(Q const &q) noexcept { sub(q); }
+};
+
+template <typename T, typename Unit, std::size_t Shards = 16>
+using sharded_atomic_quantity = basic_sharded_atomic_quantity<
+    T, typename detail::get_scale<Unit>::type,
+    typename detail::get_base_unit_list<Unit>::type, Shards>;
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef BST_UNITS_BINARY_HPP_
+#define BST_UNITS_BINARY_HPP_
+
+//==============================================================================
+
+#include "bits/conversion.hpp"
+#include "units.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+//==============================================================================
+// A binary format for batches of quantities.
+//
+// A batch is a fixed-size header followed by the raw values. The header
+// records the value type, the number of values, the dimension as (tag, power)
+// pairs, and the exact scale ratio, so the unit is written once per batch
+// rather than once per value. The values start at a 64-byte aligned offset,
+// so a batch in a page-aligned buffer, such as a mapped file, can be viewed
+// in place. Values are stored in the writer's native byte order; readers
+// reject batches written with the other byte order.
+namespace units {
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+inline constexpr std::size_t batch_alignment = 64;
+inline constexpr int max_batch_dimensions = 16;
+
+struct batch_header {
+  char magic[4];
+  std::uint16_t byte_order;
+  std::uint8_t value_kind;
+  std::uint8_t value_size;
+  std::uint32_t dimension_count;
+  std::uint32_t payload_offset;
+  std::uint64_t count;
+  std::int64_t scale_num;
+  std::int64_t scale_den;
+  std::int32_t dimensions[max_batch_dimensions][2];
+};
+
+inline constexpr char batch_magic[4] = {'U', 'Q', 'B', '1'};
+inline constexpr std::uint16_t native_byte_order = 0x0102;
+
+inline constexpr std::uint32_t batch_payload_offset =
+    (sizeof(batch_header) + batch_alignment - 1) / batch_alignment *
+    batch_alignment;
+
+enum value_kind : std::uint8_t { signed_integer, unsigned_integer, floating };
+
+template <typename T> constexpr std::uint8_t kind_of() {
+  static_assert(std::is_arithmetic_v<T>,
+                "Only arithmetic value types can be serialized");
+
+  if constexpr (std::is_floating_point_v<T>)
+    return floating;
+  else if constexpr (std::is_signed_v<T>)
+    return signed_integer;
+  else
+    return unsigned_integer;
+}
+
+// Whether size is the size of an arithmetic type of the given kind.
+constexpr bool valid_value_type(std::uint8_t kind, std::uint8_t size) {
+  switch (kind) {
+  case signed_integer:
+  case unsigned_integer:
+    return size == 1 || size == 2 || size == 4 || size == 8;
+  case floating:
+    return size == sizeof(float) || size == sizeof(double) ||
+           size == sizeof(long double);
+  default:
+    return false;
+  }
+}
+
+template <typename Quantity> struct batch_signature;
+
+template <typename T, typename S, typename... Pairs>
+struct batch_signature<basic_quantity<T, S, meta::type_list<Pairs...>>> {
+  static_assert(sizeof...(Pairs) <= max_batch_dimensions,
+                "Too many base units to serialize");
+  static_assert(is_ratio_scale<S>,
+                "Only scales that fit in a std::ratio can be serialized");
+
+  static void write(batch_header &h) {
+    h.value_kind = kind_of<T>();
+    h.value_size = sizeof(T);
+    h.dimension_count = sizeof...(Pairs);
+    h.scale_num = S::num;
+    h.scale_den = S::den;
+
+    int i = 0;
+    ((h.dimensions[i][0] = Pairs::unit::tag,
+      h.dimensions[i][1] = Pairs::power, ++i),
+     ...);
+  }
+
+  static bool same_value_type(batch_header const &h) {
+    return h.value_kind == kind_of<T>() && h.value_size == sizeof(T);
+  }
+
+  static bool same_dimension(batch_header const &h) {
+    if (h.dimension_count != sizeof...(Pairs))
+      return false;
+
+    int i = 0;
+    bool same = true;
+    ((same = same && h.dimensions[i][0] == Pairs::unit::tag &&
+             h.dimensions[i][1] == Pairs::power,
+      ++i),
+     ...);
+    return same;
+  }
+
+  static bool same_scale(batch_header const &h) {
+    return h.scale_num == S::num && h.scale_den == S::den;
+  }
+};
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+// The number of bytes needed to encode n values.
+inline std::size_t encoded_batch_size(std::size_t n, std::size_t value_size) {
+  return detail::batch_payload_offset + n * value_size;
+}
+
+// Write values as one batch at the start of out, which must hold at least
+// encoded_batch_size(values.size(), sizeof(T)) bytes. Returns the number of
+// bytes written.
+template <detail::quantity_element Q, std::size_t N>
+std::size_t encode_batch(std::span<Q, N> values, std::span<std::byte> out) {
+  using quantity_type = std::remove_const_t<Q>;
+  using T = typename quantity_type::value_type;
+
+  auto const size = encoded_batch_size(values.size(), sizeof(T));
+  assert(out.size() >= size);
+
+  detail::batch_header h{};
+  std::memcpy(h.magic, detail::batch_magic, sizeof h.magic);
+  h.byte_order = detail::native_byte_order;
+  h.payload_offset = detail::batch_payload_offset;
+  h.count = values.size();
+  detail::batch_signature<quantity_type>::write(h);
+
+  std::memset(out.data(), 0, detail::batch_payload_offset);
+  std::memcpy(out.data(), &h, sizeof h);
+  std::memcpy(out.data() + detail::batch_payload_offset, values.data(),
+              values.size() * sizeof(T));
+
+  return size;
+}
+
+//------------------------------------------------------------------------------
+
+// A batch decoded from bytes. Malformed batches throw std::runtime_error, and
+// asking for a quantity of a different dimension or value type throws
+// std::domain_error.
+class batch_reader {
+  detail::batch_header h;
+  std::span<std::byte const> payload;
+
+  template <typename Quantity> void check_convertible() const {
+    using signature = detail::batch_signature<Quantity>;
+
+    if (!signature::same_value_type(h))
+      throw std::domain_error{"units::batch_reader: value type mismatch"};
+    if (!signature::same_dimension(h))
+      throw std::domain_error{"units::batch_reader: dimension mismatch"};
+  }
+
+public:
+  explicit batch_reader(std::span<std::byte const> bytes) {
+    if (bytes.size() < sizeof h)
+      throw std::runtime_error{"units::batch_reader: truncated header"};
+
+    std::memcpy(&h, bytes.data(), sizeof h);
+
+    if (std::memcmp(h.magic, detail::batch_magic, sizeof h.magic) != 0)
+      throw std::runtime_error{"units::batch_reader: not a quantity batch"};
+    if (h.byte_order != detail::native_byte_order)
+      throw std::runtime_error{"units::batch_reader: foreign byte order"};
+    if (h.dimension_count > detail::max_batch_dimensions || h.scale_num <= 0 ||
+        h.scale_den <= 0 || h.payload_offset < sizeof h ||
+        !detail::valid_value_type(h.value_kind, h.value_size))
+      throw std::runtime_error{"units::batch_reader: malformed header"};
+
+    auto const payload_size = h.count * h.value_size;
+    if (bytes.size() < h.payload_offset ||
+        (bytes.size() - h.payload_offset) / h.value_size < h.count)
+      throw std::runtime_error{"units::batch_reader: truncated payload"};
+
+    payload = bytes.subspan(h.payload_offset, payload_size);
+  }
+
+  auto size() const { return static_cast<std::size_t>(h.count); }
+
+  // The bytes taken up by this batch; the next batch, if any, follows.
+  auto encoded_size() const {
+    return static_cast<std::size_t>(h.payload_offset) + payload.size();
+  }
+
+  // Whether the batch holds exactly Quantity, and can be viewed in place.
+  template <typename Quantity> bool holds() const {
+    using signature = detail::batch_signature<Quantity>;
+    return signature::same_value_type(h) && signature::same_dimension(h) &&
+           signature::same_scale(h);
+  }
+
+  // View the values in place, without copying. The batch must hold exactly
+  // Quantity, and the underlying buffer must be suitably aligned.
+  template <typename Quantity> std::span<Quantity const> view() const {
+    if (!holds<Quantity>())
+      throw std::domain_error{"units::batch_reader: quantity type mismatch"};
+    if (reinterpret_cast<std::uintptr_t>(payload.data()) % alignof(Quantity))
+      throw std::runtime_error{"units::batch_reader: misaligned payload"};
+
+    return {reinterpret_cast<Quantity const *>(payload.data()), size()};
+  }
+
+  // Copy the values into out, which must hold at least size() elements,
+  // converting from the batch's scale into Quantity's in a single pass.
+  template <typename Q, std::size_t N>
+    requires detail::is_quantity<Q>::value
+  void read(std::span<Q, N> out) const {
+    using quantity_type = Q;
+    using T = typename Q::value_type;
+    using S = typename Q::scale;
+
+    check_convertible<quantity_type>();
+    assert(out.size() >= size());
+
+    auto const n = size();
+    auto const *src = payload.data();
+
+    if (holds<quantity_type>()) {
+      std::memcpy(out.data(), src, n * sizeof(T));
+      return;
+    }
+
+    // (num / den) / (S::num / S::den), reduced.
+    auto num = h.scale_num;
+    auto den = h.scale_den;
+    auto const g1 = std::gcd(num, std::intmax_t{S::num});
+    auto const g2 = std::gcd(den, std::intmax_t{S::den});
+
+    using wide = std::conditional_t<std::is_floating_point_v<T>, long double,
+                                    detail::wide_intermediate_t<T>>;
+    auto const ratio_num =
+        static_cast<wide>(num / g1) * static_cast<wide>(S::den / g2);
+    auto const ratio_den =
+        static_cast<wide>(den / g2) * static_cast<wide>(S::num / g1);
+
+    if constexpr (std::is_floating_point_v<T>) {
+      auto const factor = static_cast<T>(ratio_num / ratio_den);
+      for (std::size_t i = 0; i < n; ++i) {
+        T v;
+        std::memcpy(&v, src + i * sizeof(T), sizeof(T));
+        out[i] = quantity_type{v * factor};
+      }
+    } else {
+      for (std::size_t i = 0; i < n; ++i) {
+        T v;
+        std::memcpy(&v, src + i * sizeof(T), sizeof(T));
+        out[i] = quantity_type{
+            static_cast<T>(static_cast<wide>(v) * ratio_num / ratio_den)};
+      }
+    }
+  }
+};
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef BST_UNITS_CGS_HPP_
+#define BST_UNITS_CGS_HPP_
+
+//==============================================================================
+// The CGS system, as units::cgs, bridged to and from SI.
+
+#include "units_si.hpp"
+
+// Declarations first, then the specializations that refer to them.
+#include "bits/cgs_units.hpp"
+#include "bits/cgs_bridges.hpp"
+
+//==============================================================================
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef BST_UNITS_CHRONO_HPP_
+#define BST_UNITS_CHRONO_HPP_
+
+//==============================================================================
+
+#include "units.hpp"
+
+#include <chrono>
+#include <compare>
+
+//==============================================================================
+// Points in time on a std::chrono clock, for use with quantities of time.
+//
+// Quantities of time, in a base unit marked with is_second, already convert
+// to and from std::chrono::duration: implicitly when nothing can be lost,
+// explicitly otherwise. A timestamp keeps the clock's own time_point, so the
+// difference of two timestamps is taken exactly in the clock's ticks and only
+// then converted, once, into a quantity:
+//
+//   using seconds = quantity<double, si::second>;
+//   auto start = timestamp<std::chrono::steady_clock, seconds>::now();
+//   ...
+//   auto rate = bytes / (timestamp<std::chrono::steady_clock, seconds>::now() - start);
+namespace units {
+
+template <typename Clock, typename Quantity> class timestamp {
+  static_assert(detail::is_time_units<typename Quantity::base_units>,
+                "Timestamps need a quantity of time in seconds");
+
+  typename Clock::time_point tp;
+
+public:
+  using clock = Clock;
+  using quantity_type = Quantity;
+  using time_point = typename Clock::time_point;
+
+  constexpr timestamp() = default;
+  explicit constexpr timestamp(time_point const &t) : tp{t} {}
+
+  static timestamp now() { return timestamp{Clock::now()}; }
+
+  constexpr time_point get() const { return tp; }
+
+  constexpr quantity_type time_since_epoch() const {
+    return static_cast<quantity_type>(tp.time_since_epoch());
+  }
+
+  // Moving by a quantity rounds it to the clock's ticks.
+  template <typename U, typename S, typename UL>
+  constexpr timestamp &operator+=(basic_quantity<U, S, UL> const &d) {
+    tp += static_cast<typename Clock::duration>(d);
+    return *this;
+  }
+
+  template <typename U, typename S, typename UL>
+  constexpr timestamp &operator-=(basic_quantity<U, S, UL> const &d) {
+    tp -= static_cast<typename Clock::duration>(d);
+    return *this;
+  }
+};
+
+//------------------------------------------------------------------------------
+
+template <typename Clock, typename Q>
+constexpr Q operator-(timestamp<Clock, Q> const &a,
+                      timestamp<Clock, Q> const &b) {
+  return static_cast<Q>(a.get() - b.get());
+}
+
+template <typename Clock, typename Q, typename U, typename S, typename UL>
+constexpr auto operator+(timestamp<Clock, Q> t,
+                         basic_quantity<U, S, UL> const &d) {
+  return t += d;
+}
+
+template <typename U, typename S, typename UL, typename Clock, typename Q>
+constexpr auto operator+(basic_quantity<U, S, UL> const &d,
+                         timestamp<Clock, Q> t) {
+  return t += d;
+}
+
+template <typename Clock, typename Q, typename U, typename S, typename UL>
+constexpr auto operator-(timestamp<Clock, Q> t,
+                         basic_quantity<U, S, UL> const &d) {
+  return t -= d;
+}
+
+template <typename Clock, typename Q>
+constexpr bool operator==(timestamp<Clock, Q> const &a,
+                          timestamp<Clock, Q> const &b) {
+  return a.get() == b.get();
+}
+
+template <typename Clock, typename Q>
+constexpr auto operator<=>(timestamp<Clock, Q> const &a,
+                           timestamp<Clock, Q> const &b) {
+  return a.get() <=> b.get();
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef BST_UNITS_DYNAMIC_HPP_
+#define BST_UNITS_DYNAMIC_HPP_
+
+//==============================================================================
+
+#include "units.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+// The dimension of a quantity that is only known at runtime, packed into a
+// single 64-bit word. Each base_unit<Tag>, for Tag in [0, 8), owns one byte
+// holding its exponent as a signed 8-bit integer. Comparing two dimensions is
+// one integer compare, and multiplying or dividing them adds or subtracts all
+// of the exponents at once. Exponents outside [-128, 127] wrap.
+class dynamic_dimension {
+  std::uint64_t word = 0;
+
+  static constexpr std::uint64_t high_bits = 0x8080808080808080ull;
+
+  explicit constexpr dynamic_dimension(std::uint64_t w) : word{w} {}
+
+  static constexpr int shift_of(int tag) {
+    if (tag < 0 || tag >= max_base_units)
+      throw std::out_of_range{"units::dynamic_dimension: tag out of range"};
+    return 8 * tag;
+  }
+
+public:
+  static constexpr int max_base_units = 8;
+
+  constexpr dynamic_dimension() = default;
+
+  // The dimension of base_unit<Tag> raised to the given power. Tags outside
+  // [0, max_base_units) throw std::out_of_range.
+  static constexpr dynamic_dimension base(int tag, int power = 1) {
+    return dynamic_dimension{
+        std::uint64_t{static_cast<std::uint8_t>(static_cast<std::int8_t>(power))}
+        << shift_of(tag)};
+  }
+
+  constexpr int power(int tag) const {
+    return static_cast<std::int8_t>(word >> shift_of(tag));
+  }
+
+  constexpr bool dimensionless() const { return word == 0; }
+
+  constexpr std::uint64_t bits() const { return word; }
+
+  friend constexpr bool operator==(dynamic_dimension a,
+                                   dynamic_dimension b) = default;
+
+  // Lane-wise addition and subtraction: the high bit of every byte is
+  // handled separately so that no carry or borrow crosses into the next lane.
+  friend constexpr dynamic_dimension operator*(dynamic_dimension a,
+                                               dynamic_dimension b) {
+    return dynamic_dimension{
+        ((a.word & ~high_bits) + (b.word & ~high_bits)) ^
+        ((a.word ^ b.word) & high_bits)};
+  }
+
+  friend constexpr dynamic_dimension operator/(dynamic_dimension a,
+                                               dynamic_dimension b) {
+    return dynamic_dimension{
+        ((a.word | high_bits) - (b.word & ~high_bits)) ^
+        ((a.word ^ ~b.word) & high_bits)};
+  }
+};
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename UnitList> struct packed_dimension;
+
+template <typename... Pairs>
+struct packed_dimension<meta::type_list<Pairs...>> {
+  static_assert(((Pairs::unit::tag >= 0 &&
+                  Pairs::unit::tag < dynamic_dimension::max_base_units) &&
+                 ...),
+                "Base unit tag does not fit in a dynamic_dimension");
+  static_assert(((Pairs::power >= -128 && Pairs::power <= 127) && ...),
+                "Exponent does not fit in a dynamic_dimension");
+
+  static constexpr dynamic_dimension value =
+      (dynamic_dimension{} * ... *
+       dynamic_dimension::base(Pairs::unit::tag, Pairs::power));
+};
+
+} // namespace detail
+
+// The packed dimension of a statically known unit.
+template <typename Unit>
+inline constexpr dynamic_dimension dimension_of =
+    detail::packed_dimension<
+        typename detail::get_base_unit_list<Unit>::type>::value;
+
+//------------------------------------------------------------------------------
+
+// A quantity whose unit is only known at runtime: a value, the factor that
+// takes it to coherent base units, and its packed dimension. Mixing
+// incompatible dimensions throws std::domain_error.
+template <typename T> class dynamic_quantity {
+  T val;
+  double factor;
+  dynamic_dimension dim;
+
+public:
+  using value_type = T;
+
+  constexpr dynamic_quantity(value_type const &v, dynamic_dimension d,
+                             double scale = 1.0)
+      : val{v}, factor{scale}, dim{d} {}
+
+  // Every static quantity has a dynamic counterpart.
+  template <typename S, typename UL>
+  constexpr dynamic_quantity(basic_quantity<T, S, UL> const &q)
+      : val{q.get()}, factor{detail::scale_factor<double, S, std::ratio<1, 1>>},
+        dim{detail::packed_dimension<UL>::value} {}
+
+  constexpr auto get() const { return val; }
+  constexpr auto scale() const { return factor; }
+  constexpr auto dimension() const { return dim; }
+
+  // Converting back to a static quantity checks the dimension, then rescales.
+  template <typename U, typename S, typename UL>
+  explicit constexpr operator basic_quantity<U, S, UL>() const {
+    if (dim != detail::packed_dimension<UL>::value)
+      throw std::domain_error{"units::dynamic_quantity: dimension mismatch"};
+
+    constexpr double to_scale = detail::scale_factor<double, S, std::ratio<1, 1>>;
+
+    if (factor == to_scale)
+      return basic_quantity<U, S, UL>{static_cast<U>(val)};
+    return basic_quantity<U, S, UL>{static_cast<U>(val * (factor / to_scale))};
+  }
+};
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+constexpr void check_same_dimension(dynamic_dimension a, dynamic_dimension b,
+                                 char const *what) {
+  if (a != b)
+    throw std::domain_error{what};
+}
+
+} // namespace detail
+
+// As with static quantities, addition and subtraction are carried out in the
+// finer of the two scales.
+template <typename T1, typename T2>
+constexpr auto operator+(dynamic_quantity<T1> const &v1,
+                         dynamic_quantity<T2> const &v2) {
+  detail::check_same_dimension(
+      v1.dimension(), v2.dimension(),
+      "units::dynamic_quantity: units are not compatible for addition");
+
+  using value_type = std::common_type_t<T1, T2>;
+
+  if (v1.scale() == v2.scale())
+    return dynamic_quantity<value_type>{
+        static_cast<value_type>(v1.get()) +
+            static_cast<value_type>(v2.get()),
+        v1.dimension(), v1.scale()};
+  if (v1.scale() < v2.scale())
+    return dynamic_quantity<value_type>{
+        static_cast<value_type>(v1.get() +
+                                v2.get() * (v2.scale() / v1.scale())),
+        v1.dimension(), v1.scale()};
+  return dynamic_quantity<value_type>{
+      static_cast<value_type>(v1.get() * (v1.scale() / v2.scale()) +
+                              v2.get()),
+      v2.dimension(), v2.scale()};
+}
+
+template <typename T1, typename T2>
+constexpr auto operator-(dynamic_quantity<T1> const &v1,
+                         dynamic_quantity<T2> const &v2) {
+  detail::check_same_dimension(
+      v1.dimension(), v2.dimension(),
+      "units::dynamic_quantity: units are not compatible for subtraction");
+
+  using value_type = std::common_type_t<T1, T2>;
+
+  if (v1.scale() == v2.scale())
+    return dynamic_quantity<value_type>{
+        static_cast<value_type>(v1.get()) -
+            static_cast<value_type>(v2.get()),
+        v1.dimension(), v1.scale()};
+  if (v1.scale() < v2.scale())
+    return dynamic_quantity<value_type>{
+        static_cast<value_type>(v1.get() -
+                                v2.get() * (v2.scale() / v1.scale())),
+        v1.dimension(), v1.scale()};
+  return dynamic_quantity<value_type>{
+      static_cast<value_type>(v1.get() * (v1.scale() / v2.scale()) -
+                              v2.get()),
+      v2.dimension(), v2.scale()};
+}
+
+template <typename T1, typename T2>
+constexpr auto operator*(dynamic_quantity<T1> const &v1,
+                         dynamic_quantity<T2> const &v2) {
+  using value_type = std::common_type_t<T1, T2>;
+
+  return dynamic_quantity<value_type>{
+      static_cast<value_type>(v1.get()) * static_cast<value_type>(v2.get()),
+      v1.dimension() * v2.dimension(), v1.scale() * v2.scale()};
+}
+
+template <typename T1, typename T2>
+constexpr auto operator/(dynamic_quantity<T1> const &v1,
+                         dynamic_quantity<T2> const &v2) {
+  using value_type = std::common_type_t<T1, T2>;
+
+  return dynamic_quantity<value_type>{
+      static_cast<value_type>(v1.get()) / static_cast<value_type>(v2.get()),
+      v1.dimension() / v2.dimension(), v1.scale() / v2.scale()};
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef BST_UNITS_FORMAT_HPP_
+#define BST_UNITS_FORMAT_HPP_
+
+//==============================================================================
+
+#include "units.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+// Writes into out when it is non-null, and counts the characters either way,
+// so the same code both sizes and fills a suffix at compile time.
+class suffix_writer {
+  char *out;
+  std::size_t n = 0;
+
+public:
+  explicit constexpr suffix_writer(char *p) : out{p} {}
+
+  constexpr std::size_t size() const { return n; }
+
+  constexpr void put(std::string_view s) {
+    for (char c : s) {
+      if (out)
+        out[n] = c;
+      ++n;
+    }
+  }
+
+  constexpr void put_integer(std::intmax_t v) {
+    if (v < 0) {
+      put("-");
+      v = -v;
+    }
+    if (v >= 10)
+      put_integer(v / 10);
+    char const digit[] = {static_cast<char>('0' + v % 10), '\0'};
+    put(digit);
+  }
+
+  constexpr void put_superscript(int p) {
+    constexpr std::string_view digits[] = {"⁰", "¹", "²", "³", "⁴",
+                                           "⁵", "⁶", "⁷", "⁸", "⁹"};
+    if (p < 0) {
+      put("⁻");
+      p = -p;
+    }
+    if (p >= 10)
+      put_superscript(p / 10);
+    put(digits[p % 10]);
+  }
+};
+
+template <typename Scale, typename UnitList> struct suffix_builder;
+
+template <typename Scale, typename... Pairs>
+struct suffix_builder<Scale, meta::type_list<Pairs...>> {
+  template <typename Pair>
+  static constexpr void write_pair(suffix_writer &w, bool &first,
+                                   bool positive) {
+    if ((Pair::power > 0) != positive)
+      return;
+
+    if (!first)
+      w.put("·");
+    first = false;
+
+    constexpr auto name = base_unit_symbol<Pair::unit::tag>;
+    if constexpr (name.empty()) {
+      w.put("[");
+      w.put_integer(Pair::unit::tag);
+      w.put("]");
+    } else
+      w.put(name);
+
+    if constexpr (Pair::power != 1)
+      w.put_superscript(Pair::power);
+  }
+
+  static constexpr void write_rational(suffix_writer &w, magnitude const &r,
+                                       bool &first) {
+    int two = 0;
+    int five = 0;
+    for (std::size_t i = 0; i < r.size; ++i) {
+      if (r.items[i].prime == 2)
+        two = r.items[i].power;
+      if (r.items[i].prime == 5)
+        five = r.items[i].power;
+    }
+
+    int ten = 0;
+    if (two > 0 && five > 0)
+      ten = two < five ? two : five;
+    else if (two < 0 && five < 0)
+      ten = two > five ? two : five;
+
+    if (r.sign < 0)
+      w.put("-");
+    if (ten != 0) {
+      w.put("10");
+      w.put_superscript(ten);
+      first = false;
+    }
+
+    for (std::size_t i = 0; i < r.size; ++i) {
+      auto p = r.items[i].power;
+      if (r.items[i].prime == 2 || r.items[i].prime == 5)
+        p -= ten;
+      if (p == 0)
+        continue;
+
+      if (!first)
+        w.put("·");
+      w.put_integer(r.items[i].prime);
+      if (p != 1)
+        w.put_superscript(p);
+      first = false;
+    }
+  }
+
+  static constexpr void write(suffix_writer &w) {
+    bool first = true;
+
+    constexpr magnitude m = magnitude_of<Scale>::value;
+
+    // The rational part as a fraction if it fits, otherwise as a power of ten
+    // times any other primes, e.g. "10²⁴".
+    constexpr magnitude rational = [] {
+      constexpr magnitude all = magnitude_of<Scale>::value;
+      magnitude r{all.sign, {}, 0};
+      for (std::size_t i = 0; i < all.size; ++i)
+        if (all.items[i].prime != 0)
+          r.multiply(all.items[i]);
+      return r;
+    }();
+    constexpr ratio_fit fit = fit_ratio(rational);
+
+    if constexpr (fit.fits && fit.den != 1) {
+      w.put("(");
+      w.put_integer(fit.num);
+      w.put("/");
+      w.put_integer(fit.den);
+      w.put(")");
+      first = false;
+    } else if constexpr (fit.fits && fit.num != 1) {
+      w.put_integer(fit.num);
+      first = false;
+    } else if constexpr (!fit.fits)
+      write_rational(w, rational, first);
+
+    for (std::size_t i = rational.size; i < m.size; ++i) {
+      if (!first)
+        w.put("·");
+      w.put(std::string_view{m.items[i].constant.symbol});
+      if (m.items[i].power != 1)
+        w.put_superscript(m.items[i].power);
+      first = false;
+    }
+
+    // Units with positive powers come first, as in "kg·m·s⁻²".
+    (write_pair<Pairs>(w, first, true), ...);
+    (write_pair<Pairs>(w, first, false), ...);
+  }
+};
+
+template <typename Scale, typename UnitList> struct unit_suffix {
+  using builder = suffix_builder<Scale, UnitList>;
+
+  static constexpr std::size_t size = [] {
+    suffix_writer w{nullptr};
+    builder::write(w);
+    return w.size();
+  }();
+
+  static constexpr std::array<char, size> chars = [] {
+    std::array<char, size> a{};
+    suffix_writer w{a.data()};
+    builder::write(w);
+    return a;
+  }();
+
+  static constexpr std::string_view value{chars.data(), size};
+};
+
+} // namespace detail
+
+// The unit of a quantity type as text, e.g. "m·kg·s⁻²", built entirely at
+// compile time. Base units appear in tag order, those with positive powers
+// first, and a scale other than 1 is written at the front, as in "1000·m".
+template <typename Quantity>
+inline constexpr std::string_view unit_symbol_of =
+    detail::unit_suffix<typename Quantity::scale,
+                        typename Quantity::base_units>::value;
+
+//------------------------------------------------------------------------------
+
+// Write the value followed by a space and the unit symbol. Fails with
+// std::errc::value_too_large, like std::to_chars, if there is not room.
+template <typename T, typename S, typename UL>
+std::to_chars_result to_chars(char *first, char *last,
+                              basic_quantity<T, S, UL> const &q) {
+  auto result = std::to_chars(first, last, q.get());
+  if (result.ec != std::errc{})
+    return result;
+
+  constexpr auto suffix = unit_symbol_of<basic_quantity<T, S, UL>>;
+  if constexpr (!suffix.empty()) {
+    if (static_cast<std::size_t>(last - result.ptr) < suffix.size() + 1)
+      return {last, std::errc::value_too_large};
+
+    *result.ptr++ = ' ';
+    for (char c : suffix)
+      *result.ptr++ = c;
+  }
+
+  return result;
+}
+
+} // namespace units
+//==============================================================================
+
+#if defined(__cpp_lib_format)
+
+// Format specifications apply to the value, which is followed by a space and
+// the unit symbol.
+template <typename T, typename S, typename UL>
+struct std::formatter<units::basic_quantity<T, S, UL>, char>
+    : std::formatter<T, char> {
+  template <typename FormatContext>
+  auto format(units::basic_quantity<T, S, UL> const &q,
+              FormatContext &ctx) const {
+    auto out = std::formatter<T, char>::format(q.get(), ctx);
+
+    constexpr auto suffix = units::unit_symbol_of<units::basic_quantity<T, S, UL>>;
+    if constexpr (!suffix.empty()) {
+      *out++ = ' ';
+      for (char c : suffix)
+        *out++ = c;
+    }
+
+    return out;
+  }
+};
+
+#endif
+
+//==============================================================================
+
+#endif
@@ -1,10 +1,13 @@
 #ifndef BST_UNITS_BITS_FWD_
 #define BST_UNITS_BITS_FWD_
 
+#include <string_view>
+
 //==============================================================================
 namespace units::detail {
 template <typename Unit> struct get_scale;
 template <typename Unit> struct get_base_unit_list;
+template <typename Unit> struct get_offset;
 } // namespace units::detail
 //==============================================================================
 
@@ -13,6 +16,7 @@ namespace units {
 
 template <int Tag> struct base_unit { static const int tag = Tag; };
 template <typename Scale, typename Unit> struct scaled_unit;
+template <typename Offset, typename Scale, typename Unit> struct affine_unit;
 template <typename... Params> struct derived_unit;
 
 //------------------------------------------------------------------------------
@@ -28,6 +32,37 @@ using quantity =
 
 template <typename Unit, int P> struct exp;
 
+//------------------------------------------------------------------------------
+
+// Specialize for a base unit of one system to give its exact value in
+// another, e.g. 1 m = 100 cm:
+//
+//   template <> struct units::unit_bridge<si::metre> {
+//     using type = scaled_unit<std::ratio<100>, cgs::centimetre>;
+//   };
+//
+// Quantities can then be converted between the two systems in either
+// direction. The two systems must use distinct tags.
+template <typename BaseUnit> struct unit_bridge {};
+
+// Specialize as true for the base unit that is the second, e.g.
+//
+//   template <> struct units::is_second<si::second> : std::true_type {};
+//
+// Quantities of time in that unit, however scaled, then convert to and from
+// std::chrono::duration.
+template <typename BaseUnit> struct is_second {
+  static constexpr bool value = false;
+};
+
+// The symbol printed for base_unit<Tag>. Base units are identified only by
+// their tags, so each unit system names its own, e.g.
+//
+//   template <> inline constexpr std::string_view units::base_unit_symbol<1> = "m";
+//
+// The bundled systems do so for theirs. Tags without a symbol print as "[Tag]".
+template <int Tag> inline constexpr std::string_view base_unit_symbol = "";
+
 } // namespace units
 //==============================================================================
 
@@ -0,0 +1,292 @@
+#ifndef BST_UNITS_INTERP_HPP_
+#define BST_UNITS_INTERP_HPP_
+
+//==============================================================================
+
+#include "bits/memory.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+// Piecewise linear interpolation in a table of Y against X, e.g. pressure
+// against temperature. Lookups accept X in any convertible scale, converted by
+// a factor folded at compile time; outside the table the end values are held,
+// and a NaN X gives a NaN Y. at() instead throws for an X outside the table.
+//
+// When the grid is uniform, which is detected on construction, the segment is
+// found by one multiply instead of a binary search, and the batch lookup over
+// spans vectorizes. The table either owns its values, in aligned contiguous
+// storage, or views them in place, e.g. batches in a mapped_file.
+template <typename X, typename Y> class interp_table;
+
+template <typename T, typename SX, typename ULX, typename SY, typename ULY>
+class interp_table<basic_quantity<T, SX, ULX>, basic_quantity<T, SY, ULY>> {
+  static_assert(std::is_floating_point_v<T>,
+                "Interpolation needs a floating point value type");
+
+public:
+  using value_type = T;
+  using x_type = basic_quantity<T, SX, ULX>;
+  using y_type = basic_quantity<T, SY, ULY>;
+  using size_type = std::size_t;
+
+private:
+  std::vector<x_type, aligned_allocator<x_type>> own_xs;
+  std::vector<y_type, aligned_allocator<y_type>> own_ys;
+
+  x_type const *xs = nullptr; // Null on a uniform grid.
+  y_type const *ys = nullptr;
+  size_type n = 0;
+
+  T x0{};
+  T dx{};
+  T inv_dx{};
+
+  template <typename Q> static constexpr T convert(Q const &x) {
+    static_assert(detail::is_quantity<Q>::value, "Not a quantity");
+    return static_cast<x_type>(x).get();
+  }
+
+  void set_uniform(T first, T step) {
+    if (!(step > T{}) || !std::isfinite(first))
+      throw std::invalid_argument{"units::interp_table: invalid grid step"};
+    xs = nullptr;
+    x0 = first;
+    dx = step;
+    inv_dx = T{1} / step;
+  }
+
+  // Check the grid, and drop it in favour of x0 + i * dx if it is uniform to
+  // within the rounding a grid built by repeated addition can collect.
+  void set_grid(x_type const *grid) {
+    for (size_type i = 1; i < n; ++i)
+      if (!(grid[i - 1].get() < grid[i].get()))
+        throw std::invalid_argument{
+            "units::interp_table: grid is not strictly increasing"};
+
+    auto const first = grid[0].get();
+    auto const last = grid[n - 1].get();
+    auto const step = (last - first) / static_cast<T>(n - 1);
+    auto const tol = std::numeric_limits<T>::epsilon() * static_cast<T>(n) *
+                     std::max(std::abs(first), std::abs(last));
+
+    for (size_type i = 1; i + 1 < n; ++i)
+      if (std::abs(grid[i].get() - (first + static_cast<T>(i) * step)) > tol) {
+        xs = grid;
+        return;
+      }
+
+    set_uniform(first, step);
+  }
+
+  void check_sizes(size_type nx, size_type ny) {
+    if (nx != ny)
+      throw std::invalid_argument{"units::interp_table: size mismatch"};
+    if (ny < 2)
+      throw std::invalid_argument{"units::interp_table: too few points"};
+    n = ny;
+  }
+
+  interp_table() = default;
+
+  // The lookup proper, on a value already in this table's x scale. The
+  // clamps are ordered so that a NaN passes through them into the result,
+  // while the index is taken from a copy in which it is 0.
+
+  T uniform_lookup(T v) const {
+    auto const last = static_cast<T>(n - 1);
+
+    auto t = (v - x0) * inv_dx;
+    t = t < T{} ? T{} : t;
+    t = t > last ? last : t;
+
+    auto i = static_cast<size_type>(t >= T{} ? t : T{});
+    i = i < n - 2 ? i : n - 2;
+
+    auto const f = t - static_cast<T>(i);
+    auto const y0 = ys[i].get();
+    return y0 + f * (ys[i + 1].get() - y0);
+  }
+
+  T grid_lookup(T v) const {
+    // Branchless binary search for the last segment starting at or below v.
+    size_type base = 0;
+    size_type len = n - 1;
+    while (len > 1) {
+      auto const half = len / 2;
+      base = xs[base + half].get() <= v ? base + half : base;
+      len -= half;
+    }
+
+    auto const xa = xs[base].get();
+    auto const xb = xs[base + 1].get();
+    auto f = (v - xa) / (xb - xa);
+    f = f < T{} ? T{} : f;
+    f = f > T{1} ? T{1} : f;
+
+    auto const y0 = ys[base].get();
+    return y0 + f * (ys[base + 1].get() - y0);
+  }
+
+public:
+  // A table over the given grid points, copied into the table.
+  interp_table(std::span<x_type const> grid, std::span<y_type const> values)
+      : own_xs(grid.begin(), grid.end()),
+        own_ys(values.begin(), values.end()) {
+    check_sizes(grid.size(), values.size());
+    ys = own_ys.data();
+    set_grid(own_xs.data());
+    if (!xs)
+      own_xs = {};
+  }
+
+  // A table over the uniform grid first, first + step, ..., with the values
+  // copied into the table.
+  interp_table(x_type first, x_type step, std::span<y_type const> values)
+      : own_ys(values.begin(), values.end()) {
+    check_sizes(values.size(), values.size());
+    ys = own_ys.data();
+    set_uniform(first.get(), step.get());
+  }
+
+  // Tables that refer to the values in place instead of copying them. The
+  // values must outlive the table.
+
+  static interp_table view(std::span<x_type const> grid,
+                           std::span<y_type const> values) {
+    interp_table t;
+    t.check_sizes(grid.size(), values.size());
+    t.ys = values.data();
+    t.set_grid(grid.data());
+    return t;
+  }
+
+  static interp_table view(x_type first, x_type step,
+                           std::span<y_type const> values) {
+    interp_table t;
+    t.check_sizes(values.size(), values.size());
+    t.ys = values.data();
+    t.set_uniform(first.get(), step.get());
+    return t;
+  }
+
+  interp_table(interp_table const &o)
+      : own_xs(o.own_xs), own_ys(o.own_ys), xs(o.xs), ys(o.ys), n(o.n),
+        x0(o.x0), dx(o.dx), inv_dx(o.inv_dx) {
+    if (!own_xs.empty())
+      xs = own_xs.data();
+    if (!own_ys.empty())
+      ys = own_ys.data();
+  }
+
+  interp_table(interp_table &&) noexcept = default;
+
+  interp_table &operator=(interp_table const &o) {
+    if (this != &o)
+      *this = interp_table{o};
+    return *this;
+  }
+
+  interp_table &operator=(interp_table &&) noexcept = default;
+
+  auto size() const { return n; }
+  bool uniform() const { return xs == nullptr; }
+
+  x_type x(size_type i) const {
+    assert(i < n);
+    return xs ? xs[i] : x_type{x0 + static_cast<T>(i) * dx};
+  }
+
+  y_type y(size_type i) const {
+    assert(i < n);
+    return ys[i];
+  }
+
+  template <typename Q> y_type operator()(Q const &x) const {
+    auto const v = convert(x);
+    return y_type{xs ? grid_lookup(v) : uniform_lookup(v)};
+  }
+
+  // As operator(), but throws std::out_of_range for an X outside the table,
+  // including a NaN, rather than holding the end values.
+  template <typename Q> y_type at(Q const &x) const {
+    auto const v = convert(x);
+    if (!(v >= this->x(0).get() && v <= this->x(n - 1).get()))
+      throw std::out_of_range{"units::interp_table: lookup outside the table"};
+    return y_type{xs ? grid_lookup(v) : uniform_lookup(v)};
+  }
+
+  // Look up every element of in, writing the results to out, which must be at
+  // least as long.
+  template <detail::quantity_element Q, std::size_t N, std::size_t M>
+  void operator()(std::span<Q, N> in, std::span<y_type, M> out) const {
+    assert(out.size() >= in.size());
+
+    auto const size = in.size();
+    auto *dst = out.data();
+
+    if (xs) {
+      for (size_type i = 0; i < size; ++i)
+        dst[i] = y_type{grid_lookup(convert(in[i]))};
+    } else if (n > static_cast<size_type>(
+                       std::numeric_limits<std::int32_t>::max())) {
+      for (size_type i = 0; i < size; ++i)
+        dst[i] = y_type{uniform_lookup(convert(in[i]))};
+    } else {
+      uniform_batch(in.data(), dst, size);
+    }
+  }
+
+private:
+  // uniform_lookup, written so that the loop vectorizes: the segment index
+  // is 32 bits wide, which vector registers can convert to and gather with,
+  // and results go to a local buffer first, which cannot alias the table.
+  template <typename Q>
+  void uniform_batch(Q const *in, y_type *dst, size_type size) const {
+    constexpr size_type chunk = 256;
+
+    auto const last = static_cast<T>(n - 1);
+    auto const top = static_cast<std::int32_t>(n - 2);
+    auto const *y = ys;
+
+    T buf[chunk];
+    for (size_type s = 0; s < size; s += chunk) {
+      auto const m = std::min(chunk, size - s);
+
+      for (size_type j = 0; j < m; ++j) {
+        auto t = (convert(in[s + j]) - x0) * inv_dx;
+        t = t < T{} ? T{} : t;
+        t = t > last ? last : t;
+
+        auto i = static_cast<std::int32_t>(t >= T{} ? t : T{});
+        i = i < top ? i : top;
+
+        auto const f = t - static_cast<T>(i);
+        auto const y0 = y[i].get();
+        buf[j] = y0 + f * (y[i + 1].get() - y0);
+      }
+
+      for (size_type j = 0; j < m; ++j)
+        dst[s + j] = y_type{buf[j]};
+    }
+  }
+};
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef BST_UNITS_MAPPED_FILE_HPP_
+#define BST_UNITS_MAPPED_FILE_HPP_
+
+//==============================================================================
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+// The mapping is POSIX only, which is why it lives in its own header rather
+// than being pulled in by the readers that accept its text or bytes.
+#if !__has_include(<sys/mman.h>)
+#error "units_mapped_file.hpp needs POSIX mmap"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//==============================================================================
+namespace units {
+
+// A read-only memory mapping of a whole file (POSIX). Failures to open or map
+// the file throw std::system_error.
+class mapped_file {
+  void *addr = nullptr;
+  std::size_t len = 0;
+
+public:
+  explicit mapped_file(char const *path) {
+    int const fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+      throw std::system_error{errno, std::generic_category(), path};
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int const err = errno;
+      ::close(fd);
+      throw std::system_error{err, std::generic_category(), path};
+    }
+
+    len = static_cast<std::size_t>(st.st_size);
+    if (len != 0) {
+      addr = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED) {
+        int const err = errno;
+        ::close(fd);
+        addr = nullptr;
+        throw std::system_error{err, std::generic_category(), path};
+      }
+      ::madvise(addr, len, MADV_SEQUENTIAL);
+    }
+
+    ::close(fd);
+  }
+
+  mapped_file(mapped_file &&other) noexcept
+      : addr{std::exchange(other.addr, nullptr)},
+        len{std::exchange(other.len, 0)} {}
+
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    std::swap(addr, other.addr);
+    std::swap(len, other.len);
+    return *this;
+  }
+
+  mapped_file(mapped_file const &) = delete;
+  mapped_file &operator=(mapped_file const &) = delete;
+
+  ~mapped_file() {
+    if (addr)
+      ::munmap(addr, len);
+  }
+
+  auto size() const { return len; }
+
+  auto bytes() const {
+    return std::span<std::byte const>{static_cast<std::byte const *>(addr),
+                                      len};
+  }
+
+  auto text() const {
+    return std::string_view{static_cast<char const *>(addr), len};
+  }
+};
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef BST_UNITS_MATH_HPP_
+#define BST_UNITS_MATH_HPP_
+
+//==============================================================================
+
+#include "bits/conversion.hpp"
+#include "units.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+//==============================================================================
+// Math functions on quantities. Result dimensions and scales are worked out
+// at compile time, e.g. sqrt of m² is in m and pow<3> of km is in km³. The
+// functions are found by argument dependent lookup, so unqualified calls pick
+// them up alongside those of <cmath>.
+//
+// The span forms apply the same operation to whole ranges. Their loops do no
+// more per element than the underlying <cmath> call and a constant multiply,
+// so the compiler can vectorize them. std::sqrt, std::abs and std::fma map to
+// single instructions; -fno-math-errno is needed for sqrt, and a target with
+// FMA (e.g. -mfma) for fma.
+namespace units {
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+// x^N by repeated squaring, with the multiplies unrolled at compile time.
+template <int N, typename T> constexpr T int_power(T const &x) {
+  if constexpr (N < 0)
+    return T{1} / int_power<-N>(x);
+  else if constexpr (N == 0)
+    return T{1};
+  else if constexpr (N == 1)
+    return x;
+  else {
+    T const half = int_power<N / 2>(x);
+    if constexpr (N % 2 == 0)
+      return half * half;
+    else
+      return half * half * x;
+  }
+}
+
+template <typename Quantity, int N> struct power_of;
+
+template <typename T, typename S, typename UL, int N>
+struct power_of<basic_quantity<T, S, UL>, N> {
+  using type =
+      basic_quantity<T, typename scale_power<S, N>::type,
+                     typename combined_units<weighted_units<UL, N>>::type>;
+};
+
+// Whether every power in a dimension divides by N.
+template <typename UnitList, int N> inline constexpr bool has_root = false;
+
+template <typename... Pairs, int N>
+inline constexpr bool has_root<meta::type_list<Pairs...>, N> =
+    ((Pairs::power % N == 0) && ...);
+
+// The N-th root of a quantity. Whatever part of the scale has no exact root
+// is folded into the value first, as a single constant factor.
+template <typename Quantity, int N> struct root_of_quantity;
+
+template <typename T, typename S, typename... Pairs, int N>
+struct root_of_quantity<basic_quantity<T, S, meta::type_list<Pairs...>>, N> {
+  static constexpr magnitude_root parts = root_of(magnitude_of<S>::value, N);
+
+  using type = basic_quantity<
+      T, typename make_scale<parts.root>::type,
+      meta::type_list<unit_power_pair<typename Pairs::unit, Pairs::power / N>...>>;
+
+  static constexpr bool is_exact = parts.remainder == magnitude{};
+
+  static constexpr T factor = static_cast<T>(magnitude_value(parts.remainder));
+};
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+template <typename T, typename S, typename UL>
+constexpr auto abs(basic_quantity<T, S, UL> const &x) {
+  return basic_quantity<T, S, UL>{x.get() < T{} ? -x.get() : x.get()};
+}
+
+// x^N, for any integral N.
+template <int N, typename T, typename S, typename UL>
+constexpr auto pow(basic_quantity<T, S, UL> const &x) {
+  using result = typename detail::power_of<basic_quantity<T, S, UL>, N>::type;
+  return result{detail::int_power<N>(x.get())};
+}
+
+template <typename T, typename S, typename UL>
+  requires detail::has_root<UL, 2>
+auto sqrt(basic_quantity<T, S, UL> const &x) {
+  using root = detail::root_of_quantity<basic_quantity<T, S, UL>, 2>;
+
+  if constexpr (root::is_exact)
+    return typename root::type{static_cast<T>(std::sqrt(x.get()))};
+  else
+    return typename root::type{
+        static_cast<T>(std::sqrt(x.get() * root::factor))};
+}
+
+template <typename T, typename S, typename UL>
+  requires detail::has_root<UL, 3>
+auto cbrt(basic_quantity<T, S, UL> const &x) {
+  using root = detail::root_of_quantity<basic_quantity<T, S, UL>, 3>;
+
+  if constexpr (root::is_exact)
+    return typename root::type{static_cast<T>(std::cbrt(x.get()))};
+  else
+    return typename root::type{
+        static_cast<T>(std::cbrt(x.get() * root::factor))};
+}
+
+// sqrt(x² + y²) without intermediate overflow, in the finer of the two
+// scales.
+template <typename T1, typename S1, typename UL1, typename T2, typename S2,
+          typename UL2>
+auto hypot(basic_quantity<T1, S1, UL1> const &x,
+           basic_quantity<T2, S2, UL2> const &y) {
+  static_assert(std::is_same_v<UL1, UL2>, "Units are not compatible for hypot");
+
+  using value_type = std::common_type_t<T1, T2>;
+  using result = basic_quantity<value_type,
+                                typename detail::additive_scale<S1, S2>::type, UL1>;
+
+  return result{static_cast<value_type>(std::hypot(
+      static_cast<result>(x).get(), static_cast<result>(y).get()))};
+}
+
+// x * y + z, rounded once. The dimension of x * y must match that of z, and
+// the result is in z's scale.
+template <typename T1, typename S1, typename UL1, typename T2, typename S2,
+          typename UL2, typename T3, typename S3, typename UL3>
+auto fma(basic_quantity<T1, S1, UL1> const &x,
+         basic_quantity<T2, S2, UL2> const &y,
+         basic_quantity<T3, S3, UL3> const &z) {
+  using product_units = typename detail::multiply_units<UL1, UL2>::type;
+  using product_scale = typename detail::multiply_scales<S1, S2>::type;
+
+  static_assert(std::is_same_v<product_units, UL3>,
+                "Units are not compatible for fma");
+
+  using value_type = std::common_type_t<T1, T2, T3>;
+  using conversion = detail::conversion<value_type, product_scale, S3>;
+
+  auto const a = static_cast<value_type>(x.get());
+  auto const b = static_cast<value_type>(y.get());
+  auto const c = static_cast<value_type>(z.get());
+
+  if constexpr (conversion::is_identity)
+    return basic_quantity<value_type, S3, UL3>{
+        static_cast<value_type>(std::fma(a, b, c))};
+  else
+    return basic_quantity<value_type, S3, UL3>{
+        static_cast<value_type>(std::fma(a, conversion::apply(b), c))};
+}
+
+//------------------------------------------------------------------------------
+
+// Element-wise forms over contiguous ranges. out.size() must be at least
+// in.size().
+
+template <detail::quantity_element Q, std::size_t N, std::size_t M>
+void abs(std::span<Q, N> in, std::span<std::remove_const_t<Q>, M> out) {
+  using quantity_type = std::remove_const_t<Q>;
+
+  assert(out.size() >= in.size());
+
+  auto const n = in.size();
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = quantity_type{std::abs(in[i].get())};
+}
+
+template <int P, detail::quantity_element Q, std::size_t N, std::size_t M>
+void pow(
+    std::span<Q, N> in,
+    std::span<typename detail::power_of<std::remove_const_t<Q>, P>::type, M>
+        out) {
+  assert(out.size() >= in.size());
+
+  auto const n = in.size();
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = pow<P>(in[i]);
+}
+
+template <detail::quantity_element Q, std::size_t N, std::size_t M>
+  requires detail::has_root<typename Q::base_units, 2>
+void sqrt(std::span<Q, N> in,
+          std::span<typename detail::root_of_quantity<std::remove_const_t<Q>,
+                                                      2>::type,
+                    M>
+              out) {
+  assert(out.size() >= in.size());
+
+  auto const n = in.size();
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = sqrt(in[i]);
+}
+
+// Unlike the scalar form, this is sqrt(x² + y²) computed directly, which
+// vectorizes but can overflow for values near the limits of T.
+template <detail::quantity_element Q1, std::size_t N1,
+          detail::quantity_element Q2, std::size_t N2, std::size_t M>
+  requires std::same_as<std::remove_const_t<Q1>, std::remove_const_t<Q2>>
+void hypot(std::span<Q1, N1> x, std::span<Q2, N2> y,
+           std::span<std::remove_const_t<Q1>, M> out) {
+  using quantity_type = std::remove_const_t<Q1>;
+  using value_type = typename quantity_type::value_type;
+
+  assert(y.size() >= x.size() && out.size() >= x.size());
+
+  auto const n = x.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    auto const a = x[i].get();
+    auto const b = y[i].get();
+    out[i] = quantity_type{static_cast<value_type>(std::sqrt(a * a + b * b))};
+  }
+}
+
+template <detail::quantity_element Q1, std::size_t N1,
+          detail::quantity_element Q2, std::size_t N2,
+          detail::quantity_element Q3, std::size_t N3, std::size_t M>
+void fma(std::span<Q1, N1> x, std::span<Q2, N2> y, std::span<Q3, N3> z,
+         std::span<std::remove_const_t<Q3>, M> out) {
+  assert(y.size() >= x.size() && z.size() >= x.size() &&
+         out.size() >= x.size());
+
+  auto const n = x.size();
+  for (std::size_t i = 0; i < n; ++i)
+    out[i] = fma(x[i], y[i], z[i]);
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,359 @@
+#ifndef BST_UNITS_MATRIX_HPP_
+#define BST_UNITS_MATRIX_HPP_
+
+//==============================================================================
+
+#include "bits/memory.hpp"
+#include "bits/meta.hpp"
+#include "units.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+//==============================================================================
+// Fixed size vectors and matrices whose elements each have their own unit,
+// such as the state of a Kalman filter, [m, m/s, m/s²], and its covariance.
+//
+// A vector is a list of quantity types. A matrix is described by a list of
+// row quantities R and a list of column quantities C, and its element (i, j)
+// is R[i] / C[j]. Multiplying such a matrix by a vector of C gives a vector
+// of R, and the product of an R-by-K matrix and a K-by-C matrix is an R-by-C
+// matrix, so the units of every product are known at compile time.
+//
+// Only the values are stored, as one contiguous, aligned array of T, and all
+// arithmetic runs over that array exactly as it would on an untyped matrix.
+// Element types only come into play when a single element is read or set.
+namespace units {
+
+//------------------------------------------------------------------------------
+
+template <typename... Units> using unit_list = meta::type_list<Units...>;
+
+template <typename T, typename Quantities> class basic_quantity_vector;
+
+template <typename T, typename RowQuantities, typename ColQuantities>
+class basic_quantity_matrix;
+
+namespace detail {
+
+template <typename T, typename Units> struct quantities_of;
+
+template <typename T, typename... Units>
+struct quantities_of<T, meta::type_list<Units...>> {
+  using type = meta::type_list<quantity<T, Units>...>;
+};
+
+// The quantity type of 1 / Q.
+template <typename Q> struct inverse_quantity {
+  using type = basic_quantity<
+      typename Q::value_type,
+      typename divide_scales<std::ratio<1, 1>, typename Q::scale>::type,
+      typename divide_units<meta::type_list<>, typename Q::base_units>::type>;
+};
+
+template <typename List> struct inverse_quantities;
+
+template <typename... Qs> struct inverse_quantities<meta::type_list<Qs...>> {
+  using type = meta::type_list<typename inverse_quantity<Qs>::type...>;
+};
+
+template <std::size_t I, typename List> struct quantity_at;
+
+template <std::size_t I, typename... Qs>
+struct quantity_at<I, meta::type_list<Qs...>> {
+  using type = std::tuple_element_t<I, std::tuple<Qs...>>;
+};
+
+// Storage is aligned to the largest power of two that divides its size, up
+// to a cache line: as far as possible without adding any padding.
+template <typename T, std::size_t N>
+inline constexpr std::size_t storage_alignment = [] {
+  constexpr std::size_t bytes = N * sizeof(T);
+  constexpr std::size_t lowest_bit = bytes & (~bytes + 1);
+  return lowest_bit < default_alignment ? lowest_bit : default_alignment;
+}();
+
+// Selects the constructors that leave the elements uninitialized, for results
+// that are about to be written in full.
+struct uninitialized_t {
+  explicit uninitialized_t() = default;
+};
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+template <typename T, typename... Qs>
+class basic_quantity_vector<T, meta::type_list<Qs...>> {
+public:
+  using value_type = T;
+  using quantities = meta::type_list<Qs...>;
+
+  static constexpr std::size_t size = sizeof...(Qs);
+
+  template <std::size_t I>
+  using quantity_type = typename detail::quantity_at<I, quantities>::type;
+
+  // All elements zero.
+  constexpr basic_quantity_vector() : vals{} {}
+
+  explicit constexpr basic_quantity_vector(detail::uninitialized_t) {}
+
+  // From one quantity per element, each converted into the element's unit.
+  template <typename... Args>
+    requires(sizeof...(Args) == size && sizeof...(Args) > 0 &&
+             (detail::is_quantity<Args>::value && ...))
+  explicit constexpr basic_quantity_vector(Args const &...args)
+      : vals{static_cast<Qs>(args).get()...} {}
+
+  template <std::size_t I> constexpr auto get() const {
+    return quantity_type<I>{vals[I]};
+  }
+
+  template <std::size_t I, typename Q> constexpr void set(Q const &q) {
+    vals[I] = static_cast<quantity_type<I>>(q).get();
+  }
+
+  constexpr T *data() { return vals; }
+  constexpr T const *data() const { return vals; }
+
+  constexpr basic_quantity_vector &operator+=(basic_quantity_vector const &o) {
+    for (std::size_t i = 0; i < size; ++i)
+      vals[i] += o.vals[i];
+    return *this;
+  }
+
+  constexpr basic_quantity_vector &operator-=(basic_quantity_vector const &o) {
+    for (std::size_t i = 0; i < size; ++i)
+      vals[i] -= o.vals[i];
+    return *this;
+  }
+
+  constexpr basic_quantity_vector &operator*=(T const &s) {
+    for (std::size_t i = 0; i < size; ++i)
+      vals[i] *= s;
+    return *this;
+  }
+
+private:
+  alignas(detail::storage_alignment<T, size>) T vals[size];
+};
+
+template <typename T, typename... Units>
+using quantity_vector =
+    basic_quantity_vector<T, meta::type_list<quantity<T, Units>...>>;
+
+//------------------------------------------------------------------------------
+
+template <typename T, typename... Rs, typename... Cs>
+class basic_quantity_matrix<T, meta::type_list<Rs...>, meta::type_list<Cs...>> {
+public:
+  using value_type = T;
+  using row_quantities = meta::type_list<Rs...>;
+  using col_quantities = meta::type_list<Cs...>;
+
+  static constexpr std::size_t rows = sizeof...(Rs);
+  static constexpr std::size_t cols = sizeof...(Cs);
+
+  template <std::size_t I, std::size_t J>
+  using quantity_type =
+      decltype(typename detail::quantity_at<I, row_quantities>::type{T{}} /
+               typename detail::quantity_at<J, col_quantities>::type{T{1}});
+
+  // All elements zero.
+  constexpr basic_quantity_matrix() : vals{} {}
+
+  explicit constexpr basic_quantity_matrix(detail::uninitialized_t) {}
+
+  template <std::size_t I, std::size_t J> constexpr auto get() const {
+    return quantity_type<I, J>{vals[I * cols + J]};
+  }
+
+  template <std::size_t I, std::size_t J, typename Q>
+  constexpr void set(Q const &q) {
+    vals[I * cols + J] = static_cast<quantity_type<I, J>>(q).get();
+  }
+
+  // Elements are stored row by row.
+  constexpr T *data() { return vals; }
+  constexpr T const *data() const { return vals; }
+
+  constexpr basic_quantity_matrix &operator+=(basic_quantity_matrix const &o) {
+    for (std::size_t i = 0; i < rows * cols; ++i)
+      vals[i] += o.vals[i];
+    return *this;
+  }
+
+  constexpr basic_quantity_matrix &operator-=(basic_quantity_matrix const &o) {
+    for (std::size_t i = 0; i < rows * cols; ++i)
+      vals[i] -= o.vals[i];
+    return *this;
+  }
+
+  constexpr basic_quantity_matrix &operator*=(T const &s) {
+    for (std::size_t i = 0; i < rows * cols; ++i)
+      vals[i] *= s;
+    return *this;
+  }
+
+private:
+  alignas(detail::storage_alignment<T, rows * cols>) T vals[rows * cols];
+};
+
+// A matrix taking vectors of ColUnits to vectors of RowUnits, e.g. the
+// transition matrix of a filter.
+template <typename T, typename RowUnits, typename ColUnits>
+using quantity_matrix =
+    basic_quantity_matrix<T, typename detail::quantities_of<T, RowUnits>::type,
+                          typename detail::quantities_of<T, ColUnits>::type>;
+
+// A matrix whose element (i, j) is Units[i] * Units[j], such as the
+// covariance of a vector of Units.
+template <typename T, typename... Units>
+using covariance_matrix = basic_quantity_matrix<
+    T, meta::type_list<quantity<T, Units>...>,
+    meta::type_list<typename detail::inverse_quantity<quantity<T, Units>>::type...>>;
+
+//------------------------------------------------------------------------------
+
+// The element-wise operators write their results in place, rather than
+// copying an operand and then updating the copy.
+
+template <typename T, typename Qs>
+constexpr auto operator+(basic_quantity_vector<T, Qs> const &a,
+                         basic_quantity_vector<T, Qs> const &b) {
+  basic_quantity_vector<T, Qs> out{detail::uninitialized_t{}};
+  for (std::size_t i = 0; i < out.size; ++i)
+    out.data()[i] = a.data()[i] + b.data()[i];
+  return out;
+}
+
+template <typename T, typename Qs>
+constexpr auto operator-(basic_quantity_vector<T, Qs> const &a,
+                         basic_quantity_vector<T, Qs> const &b) {
+  basic_quantity_vector<T, Qs> out{detail::uninitialized_t{}};
+  for (std::size_t i = 0; i < out.size; ++i)
+    out.data()[i] = a.data()[i] - b.data()[i];
+  return out;
+}
+
+template <typename T, typename Qs>
+constexpr auto operator*(basic_quantity_vector<T, Qs> const &a, T const &s) {
+  basic_quantity_vector<T, Qs> out{detail::uninitialized_t{}};
+  for (std::size_t i = 0; i < out.size; ++i)
+    out.data()[i] = a.data()[i] * s;
+  return out;
+}
+
+template <typename T, typename Qs>
+constexpr auto operator*(T const &s, basic_quantity_vector<T, Qs> const &a) {
+  return a * s;
+}
+
+template <typename T, typename R, typename C>
+constexpr auto operator+(basic_quantity_matrix<T, R, C> const &a,
+                         basic_quantity_matrix<T, R, C> const &b) {
+  basic_quantity_matrix<T, R, C> out{detail::uninitialized_t{}};
+  for (std::size_t i = 0; i < out.rows * out.cols; ++i)
+    out.data()[i] = a.data()[i] + b.data()[i];
+  return out;
+}
+
+template <typename T, typename R, typename C>
+constexpr auto operator-(basic_quantity_matrix<T, R, C> const &a,
+                         basic_quantity_matrix<T, R, C> const &b) {
+  basic_quantity_matrix<T, R, C> out{detail::uninitialized_t{}};
+  for (std::size_t i = 0; i < out.rows * out.cols; ++i)
+    out.data()[i] = a.data()[i] - b.data()[i];
+  return out;
+}
+
+template <typename T, typename R, typename C>
+constexpr auto operator*(basic_quantity_matrix<T, R, C> const &a, T const &s) {
+  basic_quantity_matrix<T, R, C> out{detail::uninitialized_t{}};
+  for (std::size_t i = 0; i < out.rows * out.cols; ++i)
+    out.data()[i] = a.data()[i] * s;
+  return out;
+}
+
+template <typename T, typename R, typename C>
+constexpr auto operator*(T const &s, basic_quantity_matrix<T, R, C> const &a) {
+  return a * s;
+}
+
+//------------------------------------------------------------------------------
+
+// Matrix times vector. The vector must hold exactly the matrix's column
+// quantities, so no element needs converting.
+template <typename T, typename R, typename C>
+constexpr auto operator*(basic_quantity_matrix<T, R, C> const &m,
+                         basic_quantity_vector<T, C> const &v) {
+  using matrix = basic_quantity_matrix<T, R, C>;
+
+  basic_quantity_vector<T, R> out{detail::uninitialized_t{}};
+  auto *const y = out.data();
+  auto const *const a = m.data();
+  auto const *const x = v.data();
+
+  static_assert(matrix::cols > 0, "Empty matrix");
+
+  // Sums start from their first product, as in the matrix product below.
+  for (std::size_t i = 0; i < matrix::rows; ++i) {
+    auto sum = a[i * matrix::cols] * x[0];
+    for (std::size_t j = 1; j < matrix::cols; ++j)
+      sum += a[i * matrix::cols + j] * x[j];
+    y[i] = sum;
+  }
+  return out;
+}
+
+// Matrix times matrix. The inner quantities must match exactly.
+template <typename T, typename R, typename K, typename C>
+constexpr auto operator*(basic_quantity_matrix<T, R, K> const &m1,
+                         basic_quantity_matrix<T, K, C> const &m2) {
+  constexpr auto n = basic_quantity_matrix<T, R, K>::rows;
+  constexpr auto k = basic_quantity_matrix<T, R, K>::cols;
+  constexpr auto m = basic_quantity_matrix<T, K, C>::cols;
+
+  basic_quantity_matrix<T, R, C> out{detail::uninitialized_t{}};
+  auto *const c = out.data();
+  auto const *const a = m1.data();
+  auto const *const b = m2.data();
+
+  static_assert(k > 0, "Empty inner dimension");
+
+  // Each sum starts from its first product rather than from zero: adding a
+  // floating point zero cannot be folded away, and costs an add per element.
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < m; ++j) {
+      auto sum = a[i * k] * b[j];
+      for (std::size_t p = 1; p < k; ++p)
+        sum += a[i * k + p] * b[p * m + j];
+      c[i * m + j] = sum;
+    }
+  return out;
+}
+
+// The transpose of an R-by-C matrix is a (1/C)-by-(1/R) matrix, so that
+// element (j, i) keeps the unit R[i] / C[j].
+template <typename T, typename R, typename C>
+constexpr auto transpose(basic_quantity_matrix<T, R, C> const &m) {
+  using matrix = basic_quantity_matrix<T, R, C>;
+
+  basic_quantity_matrix<T, typename detail::inverse_quantities<C>::type,
+                        typename detail::inverse_quantities<R>::type>
+      out{detail::uninitialized_t{}};
+  auto *const b = out.data();
+  auto const *const a = m.data();
+
+  for (std::size_t i = 0; i < matrix::rows; ++i)
+    for (std::size_t j = 0; j < matrix::cols; ++j)
+      b[j * matrix::rows + i] = a[i * matrix::cols + j];
+  return out;
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
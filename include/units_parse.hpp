@@ -0,0 +1,227 @@
+#ifndef BST_UNITS_PARSE_HPP_
+#define BST_UNITS_PARSE_HPP_
+
+//==============================================================================
+
+#include "units_dynamic.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+// A unit as read from text: its dimension and the factor that takes it to
+// coherent base units.
+struct parsed_unit {
+  dynamic_dimension dimension;
+  double scale = 1.0;
+
+  friend constexpr bool operator==(parsed_unit const &,
+                                   parsed_unit const &) = default;
+};
+
+struct unit_symbol {
+  std::string_view symbol;
+  parsed_unit unit;
+};
+
+// Bind a symbol to one of a unit system's units, e.g. symbol<si::metre>("m").
+template <typename Unit> consteval unit_symbol symbol(std::string_view s) {
+  return {s,
+          {dimension_of<Unit>,
+           detail::scale_factor<double, typename detail::get_scale<Unit>::type,
+                                std::ratio<1, 1>>}};
+}
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+constexpr std::uint64_t symbol_hash(std::string_view s, std::uint64_t seed) {
+  std::uint64_t h = 0xcbf29ce484222325ull ^ seed;
+  for (char c : s) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ull;
+  }
+  return h ^ (h >> 29);
+}
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+// A set of unit symbols, indexed by a perfect hash that is found when the
+// table is built at compile time, together with a parser for unit
+// expressions over those symbols. Looking a symbol up is one hash and one
+// string compare; parsing neither allocates nor consults the locale.
+//
+// Expressions are products and quotients of symbols with optional integer
+// exponents, read left to right, e.g. "kg*m/s^2" or "km/h". A leading "1"
+// is accepted, as in "1/s". Spaces around operators are ignored.
+template <std::size_t N> class symbol_table {
+  static constexpr std::size_t slots = std::bit_ceil(2 * N);
+  static constexpr std::size_t empty = N;
+
+  std::array<unit_symbol, N> symbols;
+  std::array<std::size_t, slots> index{};
+  std::uint64_t seed = 0;
+
+  constexpr std::size_t slot_of(std::string_view s) const {
+    return detail::symbol_hash(s, seed) & (slots - 1);
+  }
+
+  constexpr bool try_seed(std::uint64_t candidate) {
+    seed = candidate;
+    index.fill(empty);
+    for (std::size_t i = 0; i < N; ++i) {
+      auto &slot = index[slot_of(symbols[i].symbol)];
+      if (slot != empty)
+        return false;
+      slot = i;
+    }
+    return true;
+  }
+
+public:
+  consteval explicit symbol_table(std::array<unit_symbol, N> const &syms)
+      : symbols{syms} {
+    for (std::size_t i = 0; i < N; ++i)
+      for (std::size_t j = i + 1; j < N; ++j)
+        if (symbols[i].symbol == symbols[j].symbol)
+          throw std::logic_error{"units::symbol_table: duplicate symbol"};
+
+    for (std::uint64_t candidate = 0; candidate < (1u << 16); ++candidate)
+      if (try_seed(candidate))
+        return;
+
+    throw std::logic_error{"units::symbol_table: no perfect hash found"};
+  }
+
+  constexpr std::size_t size() const { return N; }
+
+  constexpr std::optional<parsed_unit> find(std::string_view s) const {
+    auto const i = index[slot_of(s)];
+    if (i == empty || symbols[i].symbol != s)
+      return std::nullopt;
+    return symbols[i].unit;
+  }
+
+  constexpr std::optional<parsed_unit> parse(std::string_view s) const {
+    parsed_unit result;
+    std::size_t pos = 0;
+    bool divide = false;
+
+    auto skip_spaces = [&] {
+      while (pos < s.size() && s[pos] == ' ')
+        ++pos;
+    };
+
+    auto is_operator = [](char c) {
+      return c == '*' || c == '/' || c == '^' || c == ' ';
+    };
+
+    for (bool first = true;; first = false) {
+      skip_spaces();
+
+      auto const begin = pos;
+      while (pos < s.size() && !is_operator(s[pos]))
+        ++pos;
+      if (pos == begin)
+        return std::nullopt;
+
+      auto const name = s.substr(begin, pos - begin);
+
+      parsed_unit term;
+      if (first && name == "1")
+        term = parsed_unit{};
+      else if (auto found = find(name))
+        term = *found;
+      else
+        return std::nullopt;
+
+      skip_spaces();
+
+      int power = 1;
+      if (pos < s.size() && s[pos] == '^') {
+        ++pos;
+        skip_spaces();
+
+        bool negative = false;
+        if (pos < s.size() && s[pos] == '-') {
+          negative = true;
+          ++pos;
+        }
+
+        if (pos == s.size() || s[pos] < '0' || s[pos] > '9')
+          return std::nullopt;
+
+        power = 0;
+        while (pos < s.size() && s[pos] >= '0' && s[pos] <= '9') {
+          power = power * 10 + (s[pos++] - '0');
+          if (power > 127)
+            return std::nullopt;
+        }
+
+        if (negative)
+          power = -power;
+
+        skip_spaces();
+      }
+
+      if (divide)
+        power = -power;
+
+      // Raise the term to |power| by squaring, which takes at most 13
+      // multiplies for |power| <= 127 and rounds the scale accordingly less.
+      parsed_unit raised;
+      for (int e = power < 0 ? -power : power; e != 0; e >>= 1) {
+        if (e & 1) {
+          raised.dimension = raised.dimension * term.dimension;
+          raised.scale *= term.scale;
+        }
+        if (e > 1) {
+          term.dimension = term.dimension * term.dimension;
+          term.scale *= term.scale;
+        }
+      }
+
+      if (power < 0) {
+        result.dimension = result.dimension / raised.dimension;
+        result.scale /= raised.scale;
+      } else {
+        result.dimension = result.dimension * raised.dimension;
+        result.scale *= raised.scale;
+      }
+
+      if (pos == s.size())
+        return result;
+
+      if (s[pos] == '*')
+        divide = false;
+      else if (s[pos] == '/')
+        divide = true;
+      else
+        return std::nullopt;
+      ++pos;
+    }
+  }
+};
+
+template <typename... Symbols>
+consteval auto make_symbol_table(Symbols const &...syms) {
+  return symbol_table<sizeof...(Symbols)>{
+      std::array<unit_symbol, sizeof...(Symbols)>{syms...}};
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
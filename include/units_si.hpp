@@ -0,0 +1,15 @@
+#ifndef BST_UNITS_SI_HPP_
+#define BST_UNITS_SI_HPP_
+
+//==============================================================================
+// The SI system, as units::si, e.g. quantity<double, si::newton>.
+
+#include "units.hpp"
+
+// Declarations first, then the specializations that refer to them.
+#include "bits/si_units.hpp"
+#include "bits/si_traits.hpp"
+
+//==============================================================================
+
+#endif
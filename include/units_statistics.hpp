@@ -0,0 +1,282 @@
+#ifndef BST_UNITS_STATISTICS_HPP_
+#define BST_UNITS_STATISTICS_HPP_
+
+//==============================================================================
+
+#include "units.hpp"
+#include "units_math.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+// Streaming statistics over quantities. Results carry the units that follow
+// from the definitions: the variance of seconds is in s², and the standard
+// deviation in s.
+//
+// Accumulators are plain values. Give each thread its own, then merge them
+// when the threads are done: merging is exact for everything but rounding,
+// and needs no locks because nothing is shared until then.
+namespace units {
+
+//------------------------------------------------------------------------------
+
+// Count, minimum, maximum, mean and variance, updated one value or one batch
+// at a time. The mean and variance are kept as Welford's running mean and sum
+// of squared deviations, which stays accurate where the naive sum of squares
+// cancels badly; batches and merges are combined with Chan's formula.
+template <typename Quantity> class running_statistics;
+
+template <typename T, typename S, typename UL>
+class running_statistics<basic_quantity<T, S, UL>> {
+public:
+  using quantity_type = basic_quantity<T, S, UL>;
+
+  // The type means and variances are computed in.
+  using real_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+  using mean_type = basic_quantity<real_type, S, UL>;
+  using variance_type = decltype(mean_type{0} * mean_type{0});
+
+  constexpr std::uint64_t count() const { return n; }
+
+  constexpr quantity_type min() const { return quantity_type{lo}; }
+  constexpr quantity_type max() const { return quantity_type{hi}; }
+  constexpr mean_type mean() const { return mean_type{mu}; }
+
+  // The population variance; with fewer than two values it is zero.
+  constexpr variance_type variance() const {
+    return variance_type{n > 1 ? m2 / static_cast<real_type>(n) : real_type{}};
+  }
+
+  // The unbiased sample variance.
+  constexpr variance_type sample_variance() const {
+    return variance_type{n > 1 ? m2 / static_cast<real_type>(n - 1)
+                               : real_type{}};
+  }
+
+  auto stddev() const { return sqrt(variance()); }
+
+  constexpr void add(quantity_type const &q) {
+    auto const v = q.get();
+    auto const x = static_cast<real_type>(v);
+
+    if (n == 0) {
+      lo = hi = v;
+    } else {
+      lo = v < lo ? v : lo;
+      hi = v > hi ? v : hi;
+    }
+
+    ++n;
+    auto const delta = x - mu;
+    mu += delta / static_cast<real_type>(n);
+    m2 += delta * (x - mu);
+  }
+
+  // Add a whole batch. The batch is taken in chunks that stay in cache, and
+  // each chunk is summarized on its own, by one simple pass per statistic
+  // over independent lanes that the compiler keeps in vector registers, and
+  // then merged in.
+  void add(std::span<quantity_type const> batch) {
+    constexpr std::size_t chunk = 1024;
+
+    for (std::size_t i = 0; i < batch.size(); i += chunk)
+      merge(summarize(batch.subspan(i, std::min(chunk, batch.size() - i))));
+  }
+
+  constexpr void merge(running_statistics const &o) {
+    if (o.n == 0)
+      return;
+    if (n == 0) {
+      *this = o;
+      return;
+    }
+
+    auto const total = n + o.n;
+    auto const delta = o.mu - mu;
+    auto const weight =
+        static_cast<real_type>(o.n) / static_cast<real_type>(total);
+
+    mu += delta * weight;
+    m2 += o.m2 + delta * delta * static_cast<real_type>(n) * weight;
+    lo = o.lo < lo ? o.lo : lo;
+    hi = o.hi > hi ? o.hi : hi;
+    n = total;
+  }
+
+  friend constexpr running_statistics operator+(running_statistics a,
+                                                running_statistics const &b) {
+    a.merge(b);
+    return a;
+  }
+
+private:
+  static constexpr std::size_t lanes = 8;
+
+  static running_statistics summarize(std::span<quantity_type const> xs) {
+    auto const size = xs.size();
+    auto const full = size - size % lanes;
+
+    running_statistics part;
+    part.n = size;
+    part.lo = part.hi = xs[0].get();
+
+    real_type sum[lanes]{};
+    for (std::size_t i = 0; i < full; i += lanes)
+      for (std::size_t l = 0; l < lanes; ++l)
+        sum[l] += static_cast<real_type>(xs[i + l].get());
+
+    T lo[lanes], hi[lanes];
+    for (std::size_t l = 0; l < lanes; ++l)
+      lo[l] = hi[l] = part.lo;
+    for (std::size_t i = 0; i < full; i += lanes)
+      for (std::size_t l = 0; l < lanes; ++l) {
+        auto const v = xs[i + l].get();
+        lo[l] = v < lo[l] ? v : lo[l];
+        hi[l] = v > hi[l] ? v : hi[l];
+      }
+
+    real_type total{};
+    for (std::size_t l = 0; l < lanes; ++l) {
+      total += sum[l];
+      part.lo = lo[l] < part.lo ? lo[l] : part.lo;
+      part.hi = hi[l] > part.hi ? hi[l] : part.hi;
+    }
+    for (std::size_t i = full; i < size; ++i) {
+      auto const v = xs[i].get();
+      total += static_cast<real_type>(v);
+      part.lo = v < part.lo ? v : part.lo;
+      part.hi = v > part.hi ? v : part.hi;
+    }
+    part.mu = total / static_cast<real_type>(size);
+
+    real_type squares[lanes]{};
+    for (std::size_t i = 0; i < full; i += lanes)
+      for (std::size_t l = 0; l < lanes; ++l) {
+        auto const d = static_cast<real_type>(xs[i + l].get()) - part.mu;
+        squares[l] += d * d;
+      }
+    for (std::size_t l = 0; l < lanes; ++l)
+      part.m2 += squares[l];
+    for (std::size_t i = full; i < size; ++i) {
+      auto const d = static_cast<real_type>(xs[i].get()) - part.mu;
+      part.m2 += d * d;
+    }
+
+    return part;
+  }
+
+  std::uint64_t n = 0;
+  T lo{};
+  T hi{};
+  real_type mu{};
+  real_type m2{};
+};
+
+//------------------------------------------------------------------------------
+
+// Approximate quantiles of positive quantities, such as latencies. Values are
+// counted in logarithmically spaced buckets, so every quantile is returned to
+// within the given relative accuracy however the values are distributed, in
+// memory that grows with the logarithm of their range (the DDSketch scheme).
+// Sketches with the same accuracy merge by adding their bucket counts.
+template <typename Quantity> class quantile_sketch;
+
+template <typename T, typename S, typename UL>
+class quantile_sketch<basic_quantity<T, S, UL>> {
+public:
+  using quantity_type = basic_quantity<T, S, UL>;
+  using real_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+  using result_type = basic_quantity<real_type, S, UL>;
+
+  explicit quantile_sketch(double relative_accuracy = 0.01)
+      : gamma{(1 + relative_accuracy) / (1 - relative_accuracy)},
+        log_gamma{std::log(gamma)} {
+    assert(relative_accuracy > 0 && relative_accuracy < 1);
+  }
+
+  std::uint64_t count() const { return n; }
+
+  // Values must not be negative; zeros are counted on their own.
+  void add(quantity_type const &q) {
+    auto const v = static_cast<double>(q.get());
+    assert(v >= 0);
+
+    ++n;
+    if (v <= std::numeric_limits<double>::min()) {
+      ++zeros;
+      return;
+    }
+    ++bucket(static_cast<int>(std::ceil(std::log(v) / log_gamma)));
+  }
+
+  void add(std::span<quantity_type const> batch) {
+    for (auto const &q : batch)
+      add(q);
+  }
+
+  void merge(quantile_sketch const &o) {
+    assert(gamma == o.gamma);
+
+    n += o.n;
+    zeros += o.zeros;
+    for (std::size_t i = 0; i < o.counts.size(); ++i)
+      if (o.counts[i] != 0)
+        bucket(o.offset + static_cast<int>(i)) += o.counts[i];
+  }
+
+  // The value at quantile p, for p in [0, 1]. The sketch must not be empty.
+  result_type quantile(double p) const {
+    assert(n > 0 && p >= 0 && p <= 1);
+
+    auto const rank = static_cast<std::uint64_t>(p * static_cast<double>(n - 1));
+    if (rank < zeros)
+      return result_type{real_type{}};
+
+    auto seen = zeros;
+    std::size_t i = 0;
+    for (; i + 1 < counts.size(); ++i) {
+      seen += counts[i];
+      if (seen > rank)
+        break;
+    }
+
+    auto const index = offset + static_cast<int>(i);
+    return result_type{static_cast<real_type>(
+        2 * std::pow(gamma, index) / (gamma + 1))};
+  }
+
+private:
+  std::uint64_t &bucket(int index) {
+    if (counts.empty()) {
+      offset = index;
+      counts.resize(1);
+    } else if (index < offset) {
+      counts.insert(counts.begin(), static_cast<std::size_t>(offset - index), 0);
+      offset = index;
+    } else if (index - offset >= static_cast<int>(counts.size())) {
+      counts.resize(static_cast<std::size_t>(index - offset) + 1);
+    }
+    return counts[static_cast<std::size_t>(index - offset)];
+  }
+
+  double gamma;
+  double log_gamma;
+  std::uint64_t n = 0;
+  std::uint64_t zeros = 0;
+  int offset = 0;
+  std::vector<std::uint64_t> counts;
+};
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef BST_UNITS_TEXT_HPP_
+#define BST_UNITS_TEXT_HPP_
+
+//==============================================================================
+
+#include "units_array.hpp"
+#include "units_dynamic.hpp"
+#include "units_parse.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+//==============================================================================
+namespace units {
+
+//------------------------------------------------------------------------------
+
+struct read_options {
+  // ',' for comma separated files, or ' ' for columns separated by any run
+  // of spaces and tabs.
+  char delimiter = ',';
+
+  // Whether the first line names the columns. A header cell may carry the
+  // column's unit in brackets, e.g. "distance [km]". With ' ' as the
+  // delimiter, header cells cannot contain spaces: "distance[km]".
+  bool header = false;
+};
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+struct text_cursor {
+  char const *pos;
+  char const *end;
+  std::size_t line = 1;
+
+  bool at_line_end() const {
+    return pos == end || *pos == '\n' || *pos == '\r';
+  }
+
+  bool at_blank() const { return pos != end && (*pos == ' ' || *pos == '\t'); }
+
+  void skip_blanks() {
+    while (at_blank())
+      ++pos;
+  }
+
+  void next_line() {
+    while (pos != end && *pos != '\n')
+      ++pos;
+    if (pos != end)
+      ++pos;
+    ++line;
+  }
+};
+
+[[noreturn]] inline void malformed(text_cursor const &c, char const *what) {
+  throw std::runtime_error{std::string{"units::read_columns: "} + what +
+                           " on line " + std::to_string(c.line)};
+}
+
+inline std::string_view trim_blanks(char const *begin, char const *end) {
+  while (end != begin && (end[-1] == ' ' || end[-1] == '\t'))
+    --end;
+  return {begin, static_cast<std::size_t>(end - begin)};
+}
+
+// A column's unit, resolved once and then only compared against.
+struct column_unit {
+  std::string_view text;
+  double factor = 1.0;
+  bool resolved = false;
+};
+
+template <typename Column, std::size_t N>
+void resolve_unit(column_unit &u, std::string_view text,
+                  symbol_table<N> const &symbols, text_cursor const &c) {
+  u.text = text;
+  u.resolved = true;
+
+  // Bare numbers are taken to be in the column's own unit.
+  if (text.empty())
+    return;
+
+  auto const parsed = symbols.parse(text);
+  if (!parsed)
+    malformed(c, "unknown unit");
+  if (parsed->dimension !=
+      packed_dimension<typename Column::base_units>::value)
+    malformed(c, "unit has the wrong dimension for its column");
+
+  u.factor = parsed->scale /
+             scale_factor<double, typename Column::scale, std::ratio<1, 1>>;
+}
+
+// Read one number and the unit text that follows it, if any.
+template <typename T>
+std::string_view read_cell(text_cursor &c, char delimiter, T &value) {
+  c.skip_blanks();
+
+  auto const [ptr, ec] = std::from_chars(c.pos, c.end, value);
+  if (ec != std::errc{})
+    malformed(c, "malformed number");
+  c.pos = ptr;
+
+  c.skip_blanks();
+  auto const begin = c.pos;
+
+  if (delimiter == ' ') {
+    // The unit is the next token, unless that token starts another number.
+    auto const starts_number = [](char ch) {
+      return (ch >= '0' && ch <= '9') || ch == '-' || ch == '.';
+    };
+    if (!c.at_line_end() && !starts_number(*c.pos))
+      while (!c.at_line_end() && !c.at_blank())
+        ++c.pos;
+  } else {
+    while (!c.at_line_end() && *c.pos != delimiter)
+      ++c.pos;
+  }
+
+  return trim_blanks(begin, c.pos);
+}
+
+template <std::size_t N, typename Column>
+void read_value(text_cursor &c, read_options const &opts,
+                symbol_table<N> const &symbols, column_unit &u, Column &col,
+                bool last) {
+  using value_type = typename Column::value_type;
+  using quantity_type = typename Column::quantity_type;
+
+  value_type v{};
+  auto const unit = read_cell(c, opts.delimiter, v);
+
+  if (!u.resolved)
+    resolve_unit<Column>(u, unit, symbols, c);
+  else if (!unit.empty() && unit != u.text)
+    malformed(c, "unit changes within a column");
+
+  if (u.factor == 1.0)
+    col.push_back(quantity_type{v});
+  else
+    col.push_back(quantity_type{static_cast<value_type>(v * u.factor)});
+
+  if (opts.delimiter != ' ' && !last) {
+    if (c.pos == c.end || *c.pos != opts.delimiter)
+      malformed(c, "missing column");
+    ++c.pos;
+  }
+}
+
+template <std::size_t N, typename Column>
+void read_header_cell(text_cursor &c, read_options const &opts,
+                      symbol_table<N> const &symbols, column_unit &u,
+                      bool last) {
+  c.skip_blanks();
+
+  auto const begin = c.pos;
+  if (opts.delimiter == ' ')
+    while (!c.at_line_end() && !c.at_blank())
+      ++c.pos;
+  else
+    while (!c.at_line_end() && *c.pos != opts.delimiter)
+      ++c.pos;
+
+  auto const cell = trim_blanks(begin, c.pos);
+  auto const open = cell.find('[');
+  auto const close = cell.rfind(']');
+  if (open != std::string_view::npos && close != std::string_view::npos &&
+      open < close)
+    resolve_unit<Column>(u, cell.substr(open + 1, close - open - 1), symbols,
+                         c);
+
+  if (opts.delimiter != ' ' && !last) {
+    if (c.pos == c.end || *c.pos != opts.delimiter)
+      malformed(c, "missing column");
+    ++c.pos;
+  }
+}
+
+template <std::size_t N, typename... Columns, std::size_t... I>
+void read_header(text_cursor &c, read_options const &opts,
+                 symbol_table<N> const &symbols,
+                 std::array<column_unit, sizeof...(Columns)> &units,
+                 std::index_sequence<I...>) {
+  (read_header_cell<N, Columns>(c, opts, symbols, units[I],
+                                I + 1 == sizeof...(Columns)),
+   ...);
+}
+
+template <std::size_t N, typename... Columns, std::size_t... I>
+void read_row(text_cursor &c, read_options const &opts,
+              symbol_table<N> const &symbols,
+              std::array<column_unit, sizeof...(Columns)> &units,
+              std::index_sequence<I...>, Columns &...columns) {
+  (read_value(c, opts, symbols, units[I], columns,
+              I + 1 == sizeof...(Columns)),
+   ...);
+}
+
+} // namespace detail
+
+//------------------------------------------------------------------------------
+
+// Append the rows of a delimited text file, such as a memory-mapped one, to
+// one quantity array per column. Cells hold a number optionally followed by a
+// unit from symbols, e.g. "12.5 km". Each column's unit is resolved once,
+// from the header or else the first row, and every value is then converted
+// into the column's unit with a single precomputed factor. Numbers are read
+// with std::from_chars straight out of text, without building any strings.
+//
+// Malformed input throws std::runtime_error. Returns the number of rows read.
+template <std::size_t N, typename... Columns>
+std::size_t read_columns(std::string_view text, symbol_table<N> const &symbols,
+                         read_options const &opts, Columns &...columns) {
+  static_assert(sizeof...(Columns) > 0, "No columns to read into");
+
+  detail::text_cursor c{text.data(), text.data() + text.size()};
+  std::array<detail::column_unit, sizeof...(Columns)> units{};
+
+  if (opts.header && c.pos != c.end) {
+    detail::read_header<N, Columns...>(c, opts, symbols, units,
+                                       std::index_sequence_for<Columns...>{});
+    c.next_line();
+  }
+
+  std::size_t rows = 0;
+  while (c.pos != c.end) {
+    c.skip_blanks();
+    if (c.at_line_end()) {
+      c.next_line();
+      continue;
+    }
+
+    detail::read_row(c, opts, symbols, units,
+                     std::index_sequence_for<Columns...>{}, columns...);
+
+    c.skip_blanks();
+    if (!c.at_line_end())
+      detail::malformed(c, "too many columns");
+
+    c.next_line();
+    ++rows;
+  }
+
+  return rows;
+}
+
+} // namespace units
+//==============================================================================
+
+#endif
@@ -0,0 +1,45 @@
+//==============================================================================
+// The CGS system, prebuilt, along with the bridges that convert between it and
+// SI. The two systems use different base unit tags.
+//==============================================================================
+
+module;
+
+#include <ratio>
+#include <string_view>
+
+export module units.cgs;
+
+export import units.si;
+
+//------------------------------------------------------------------------------
+
+export {
+#include "bits/cgs_units.hpp"
+}
+
+// Specializations cannot be exported, but they are reachable from any
+// importer of this module.
+#include "bits/cgs_bridges.hpp"
+
+//------------------------------------------------------------------------------
+
+namespace units::detail {
+
+using prebuilt_cgs = meta::type_list<
+    quantity<double, cgs::centimetre>,
+    quantity<double, cgs::gram>,
+    quantity<double, cgs::second>,
+    quantity<double, cgs::centimetre_per_second>,
+    quantity<double, cgs::gal>,
+    quantity<double, cgs::dyne>,
+    quantity<double, cgs::erg>,
+    quantity<double, cgs::erg_per_second>,
+    quantity<double, cgs::barye>,
+    quantity<double, cgs::poise>,
+    quantity<double, cgs::stokes>,
+    quantity<double, cgs::kayser>>;
+
+} // namespace units::detail
+
+//==============================================================================
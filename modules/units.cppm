@@ -0,0 +1,39 @@
+//==============================================================================
+// The units module: everything in units.hpp.
+//
+// The header is included inside an export block, so its standard library
+// dependencies are included first, in the global module fragment, where
+// their include guards keep them out of the module's purview. With GCC:
+//
+//   g++ -std=c++20 -fmodules-ts -Iinclude -c -x c++ modules/units.cppm
+//
+// and with Clang:
+//
+//   clang++ -std=c++20 -Iinclude --precompile modules/units.cppm -o units.pcm
+//==============================================================================
+
+module;
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <ratio>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+export module units;
+
+export {
+#include "units.hpp"
+}
+
+//==============================================================================
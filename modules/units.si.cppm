@@ -0,0 +1,108 @@
+//==============================================================================
+// The SI system, prebuilt. The base unit lists and scales of its units are
+// worked out once, when this module is built, instead of in every translation
+// unit that uses them.
+//==============================================================================
+
+module;
+
+#include <ratio>
+#include <string_view>
+
+export module units.si;
+
+export import units;
+
+//------------------------------------------------------------------------------
+
+export {
+#include "bits/si_units.hpp"
+}
+
+// Specializations cannot be exported, but they are reachable from any
+// importer of this module.
+#include "bits/si_traits.hpp"
+
+//------------------------------------------------------------------------------
+
+// Naming each unit's quantity type here instantiates its base unit list and
+// scale inside this module, so importers find them already done. That work
+// is what is slow; explicit instantiations of the quantity classes would add
+// only their small inline members, which importers inline anyway.
+namespace units::detail {
+
+using prebuilt_si = meta::type_list<
+    quantity<double, si::second>,
+    quantity<double, si::metre>,
+    quantity<double, si::kilogram>,
+    quantity<double, si::kelvin>,
+    quantity<double, si::ampere>,
+    quantity<double, si::mole>,
+    quantity<double, si::candela>,
+    quantity<double, si::radian>,
+    quantity<double, si::steradian>,
+    quantity<double, si::hertz>,
+    quantity<double, si::newton>,
+    quantity<double, si::pascal>,
+    quantity<double, si::joule>,
+    quantity<double, si::watt>,
+    quantity<double, si::coulomb>,
+    quantity<double, si::volt>,
+    quantity<double, si::farad>,
+    quantity<double, si::ohm>,
+    quantity<double, si::siemens>,
+    quantity<double, si::weber>,
+    quantity<double, si::tesla>,
+    quantity<double, si::henry>,
+    quantity<double, si::lumen>,
+    quantity<double, si::lux>,
+    quantity<double, si::becquerel>,
+    quantity<double, si::gray>,
+    quantity<double, si::sievert>,
+    quantity<double, si::katal>,
+    quantity<double, si::square_metre>,
+    quantity<double, si::cubic_metre>,
+    quantity<double, si::metre_per_second>,
+    quantity<double, si::metre_per_second_squared>,
+    quantity<double, si::reciprocal_metre>,
+    quantity<double, si::kilogram_per_cubic_metre>,
+    quantity<double, si::kilogram_per_square_metre>,
+    quantity<double, si::cubic_metre_per_kilogram>,
+    quantity<double, si::ampere_per_square_metre>,
+    quantity<double, si::ampere_per_metre>,
+    quantity<double, si::mole_per_cubic_metre>,
+    quantity<double, si::candela_per_square_metre>,
+    quantity<double, si::pascal_second>,
+    quantity<double, si::newton_metre>,
+    quantity<double, si::newton_per_metre>,
+    quantity<double, si::radian_per_second>,
+    quantity<double, si::radian_per_second_squared>,
+    quantity<double, si::watt_per_square_metre>,
+    quantity<double, si::joule_per_kelvin>,
+    quantity<double, si::joule_per_kilogram_kelvin>,
+    quantity<double, si::joule_per_kilogram>,
+    quantity<double, si::watt_per_metre_kelvin>,
+    quantity<double, si::joule_per_cubic_metre>,
+    quantity<double, si::volt_per_metre>,
+    quantity<double, si::coulomb_per_cubic_metre>,
+    quantity<double, si::coulomb_per_square_metre>,
+    quantity<double, si::farad_per_metre>,
+    quantity<double, si::henry_per_metre>,
+    quantity<double, si::joule_per_mole>,
+    quantity<double, si::joule_per_mole_kelvin>,
+    quantity<double, si::coulomb_per_kilogram>,
+    quantity<double, si::gray_per_second>,
+    quantity<double, si::watt_per_steradian>,
+    quantity<double, si::watt_per_square_metre_steradian>,
+    quantity<double, si::katal_per_cubic_metre>,
+    quantity<double, si::minute>,
+    quantity<double, si::hour>,
+    quantity<double, si::day>,
+    quantity<double, si::astronomical_unit>,
+    quantity<double, si::hectare>,
+    quantity<double, si::litre>,
+    quantity<double, si::tonne>>;
+
+} // namespace units::detail
+
+//==============================================================================